@@ -0,0 +1,171 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+
+#ifndef LEFTICUS_TOOLS_APPLY_BATCH_HPP
+#define LEFTICUS_TOOLS_APPLY_BATCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace lefticus::tools {
+
+// run every call on the calling thread
+struct batch_sequential_t
+{
+};
+inline constexpr batch_sequential_t batch_sequential{};
+
+// split a batch across up to max_threads threads, the calling thread
+// included, giving each at least min_chunk calls; 0 means hardware_concurrency
+struct batch_parallel
+{
+  std::size_t min_chunk = std::size_t{ 1 } << 15U;
+  std::size_t max_threads = 0;
+};
+
+template<typename Policy>
+concept batch_policy = std::same_as<Policy, batch_sequential_t> || std::same_as<Policy, batch_parallel>;
+
+namespace detail {
+  // a plain indexed loop over struct-of-arrays inputs, which the optimiser can
+  // vectorise once `callable` is inlined
+  template<typename Callable, typename Output, typename... Input>
+  constexpr void apply_batch_range(const Callable &callable,
+    Output *output,
+    const std::size_t first,
+    const std::size_t last,
+    const Input *...inputs)
+  {
+    for (std::size_t index = first; index < last; ++index) {
+      output[index] = std::invoke(callable, inputs[index]...);// NOLINT pointer arithmetic
+    }
+  }
+
+  template<typename Output, typename... Input>
+  [[nodiscard]] constexpr std::size_t batch_size(const Output &output, const Input &...inputs)
+  {
+    const std::array<std::size_t, sizeof...(Input)> sizes{ std::ranges::size(inputs)... };
+    const auto size = sizes[0];
+    if (!std::ranges::all_of(sizes, [size](const auto other) { return other == size; })) {
+      throw std::invalid_argument("apply_batch inputs differ in size");
+    }
+    if (std::ranges::size(output) < size) { throw std::length_error("apply_batch output is too small"); }
+    return size;
+  }
+}// namespace detail
+
+// Calls `callable` once per row of the struct-of-arrays `inputs`, which must
+// all be the same size, writing row i's result to output[i]. Returns the part
+// of `output` that was written. `callable` is usually a partially applied
+// curry or flat_curry, and is called through a const reference, possibly from
+// several threads at once.
+template<typename Callable, std::ranges::contiguous_range Output, std::ranges::contiguous_range... Input>
+  requires(sizeof...(Input) > 0)
+          && std::is_invocable_v<const Callable &, const std::ranges::range_value_t<Input> &...>
+constexpr auto apply_batch(batch_sequential_t, const Callable &callable, Output &&output, const Input &...inputs)
+{
+  const auto size = detail::batch_size(output, inputs...);
+  detail::apply_batch_range(callable, std::ranges::data(output), 0, size, std::ranges::data(inputs)...);
+  return std::span{ std::ranges::data(output), size };
+}
+
+template<typename Callable, std::ranges::contiguous_range Output, std::ranges::contiguous_range... Input>
+  requires(sizeof...(Input) > 0)
+          && std::is_invocable_v<const Callable &, const std::ranges::range_value_t<Input> &...>
+auto apply_batch(const batch_parallel policy, const Callable &callable, Output &&output, const Input &...inputs)
+{
+  const auto size = detail::batch_size(output, inputs...);
+  auto *const results = std::ranges::data(output);
+
+  const std::size_t hardware = std::max(std::thread::hardware_concurrency(), 1U);
+  const auto threads = std::min({ policy.max_threads == 0 ? hardware : policy.max_threads,
+    size / std::max(policy.min_chunk, std::size_t{ 1 }),
+    size });
+
+  if (threads <= 1) {
+    detail::apply_batch_range(callable, results, 0, size, std::ranges::data(inputs)...);
+    return std::span{ results, size };
+  }
+
+  // the calling thread takes the first chunk; whole cache lines of output each
+  constexpr std::size_t alignment = 64;
+  const auto chunk = (size / threads + alignment - 1) / alignment * alignment;
+
+  std::vector<std::exception_ptr> failures(threads);
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t worker = 1; worker < threads; ++worker) {
+      const auto first = std::min(size, worker * chunk);
+      const auto last = worker + 1 == threads ? size : std::min(size, first + chunk);
+      workers.emplace_back([&, first, last, failure = &failures[worker]] {
+        try {
+          detail::apply_batch_range(callable, results, first, last, std::ranges::data(inputs)...);
+        } catch (...) {
+          *failure = std::current_exception();
+        }
+      });
+    }
+
+    try {
+      detail::apply_batch_range(callable, results, 0, std::min(size, chunk), std::ranges::data(inputs)...);
+    } catch (...) {
+      failures[0] = std::current_exception();
+    }
+  }
+
+  for (const auto &failure : failures) {
+    if (failure) { std::rethrow_exception(failure); }
+  }
+  return std::span{ results, size };
+}
+
+// apply_batch with the default batch_parallel policy
+template<typename Callable, std::ranges::contiguous_range Output, std::ranges::contiguous_range... Input>
+  requires(!batch_policy<Callable>) && (sizeof...(Input) > 0)
+          && std::is_invocable_v<const Callable &, const std::ranges::range_value_t<Input> &...>
+auto apply_batch(const Callable &callable, Output &&output, const Input &...inputs)
+{
+  return apply_batch(batch_parallel{}, callable, std::forward<Output>(output), inputs...);
+}
+
+}// namespace lefticus::tools
+
+#endif// LEFTICUS_TOOLS_APPLY_BATCH_HPP
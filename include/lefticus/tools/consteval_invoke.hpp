@@ -39,6 +39,11 @@ template<typename... Param> consteval decltype(auto) consteval_invoke(Param &&..
   return std::invoke(std::forward<Param>(param)...);
 }
 
+/// The result of `Function(Args...)`, computed at compile time once per translation unit for each distinct
+/// argument set and stored as a single static shared by every translation unit. Bind a `const auto &` to it to
+/// avoid copying large results.
+template<auto Function, auto... Args> inline constexpr auto constant_cache = consteval_invoke(Function, Args...);
+
 }// namespace lefticus::tools
 
 #endif
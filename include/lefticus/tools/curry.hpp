@@ -25,7 +25,13 @@ OTHER DEALINGS IN THE SOFTWARE.
 For more information, please refer to <https://unlicense.org>
 */
 
+#ifndef LEFTICUS_TOOLS_CURRY_HPP
+#define LEFTICUS_TOOLS_CURRY_HPP
+
+#include <cstddef>
 #include <functional>
+#include <type_traits>
+#include <utility>
 
 namespace lefticus::tools {
 // intentional copies, require std::reference_wrapper if people
@@ -40,4 +46,104 @@ constexpr decltype(auto) curry(auto f, auto... ps)
     return [f, ps...](auto... qs) -> decltype(auto) { return curry(f, ps..., qs...); };
   }
 }
+
+namespace detail {
+  template<std::size_t Index, typename Stored> struct curry_slot
+  {
+    [[no_unique_address]] Stored value;
+  };
+
+  // every bound argument side by side in one aggregate, in the order given
+  template<typename Indexes, typename... Stored> struct curry_storage;
+  template<std::size_t... Index, typename... Stored>
+  struct curry_storage<std::index_sequence<Index...>, Stored...> : curry_slot<Index, Stored>...
+  {
+  };
+
+  // the stored argument with the value category of the storage holding it
+  template<std::size_t Index, typename Stored, typename Storage>
+  [[nodiscard]] constexpr decltype(auto) curry_value(Storage &&storage) noexcept
+  {
+    using slot = std::conditional_t<std::is_const_v<std::remove_reference_t<Storage>>,
+      const curry_slot<Index, Stored>,
+      curry_slot<Index, Stored>>;
+    if constexpr (std::is_lvalue_reference_v<Storage>) {
+      return (static_cast<slot &>(storage).value);
+    } else {
+      return std::move(static_cast<slot &>(storage).value);
+    }
+  }
+
+  // as it is passed to the function, std::reference_wrapper becoming the reference it wraps
+  template<std::size_t Index, typename Stored, typename Storage>
+  [[nodiscard]] constexpr decltype(auto) curry_argument(Storage &&storage) noexcept
+  {
+    if constexpr (std::is_same_v<std::unwrap_reference_t<Stored>, Stored>) {
+      return curry_value<Index, Stored>(std::forward<Storage>(storage));
+    } else {
+      return curry_value<Index, Stored>(std::forward<Storage>(storage)).get();
+    }
+  }
+}// namespace detail
+
+// The result of a partial flat_curry: the function and the arguments bound so
+// far, stored flat. Calling an rvalue moves the bound arguments, either into
+// the function or into the next, wider, curried.
+template<typename Function, typename... Stored> class curried
+{
+  using storage_type = detail::curry_storage<std::index_sequence_for<Stored...>, Stored...>;
+
+public:
+  template<typename F, typename... Ps>
+  constexpr explicit curried(std::in_place_t, F &&func, Ps &&...ps)
+    : function(std::forward<F>(func)), stored{ { std::forward<Ps>(ps) }... }
+  {}
+
+  template<typename... Qs> constexpr decltype(auto) operator()(Qs &&...qs) &
+  {
+    return apply(*this, std::index_sequence_for<Stored...>{}, std::forward<Qs>(qs)...);
+  }
+  template<typename... Qs> constexpr decltype(auto) operator()(Qs &&...qs) const &
+  {
+    return apply(*this, std::index_sequence_for<Stored...>{}, std::forward<Qs>(qs)...);
+  }
+  template<typename... Qs> constexpr decltype(auto) operator()(Qs &&...qs) &&
+  {
+    return apply(std::move(*this), std::index_sequence_for<Stored...>{}, std::forward<Qs>(qs)...);
+  }
+
+private:
+  template<typename Self, std::size_t... Index, typename... Qs>
+  static constexpr decltype(auto) apply(Self &&self, std::index_sequence<Index...>, Qs &&...qs)
+  {
+    if constexpr (requires {
+                    std::invoke(std::forward<Self>(self).function,
+                      detail::curry_argument<Index, Stored>(std::forward<Self>(self).stored)...,
+                      std::forward<Qs>(qs)...);
+                  }) {
+      return std::invoke(std::forward<Self>(self).function,
+        detail::curry_argument<Index, Stored>(std::forward<Self>(self).stored)...,
+        std::forward<Qs>(qs)...);
+    } else {
+      return curried<Function, Stored..., std::decay_t<Qs>...>{ std::in_place,
+        std::forward<Self>(self).function,
+        detail::curry_value<Index, Stored>(std::forward<Self>(self).stored)...,
+        std::forward<Qs>(qs)... };
+    }
+  }
+
+  [[no_unique_address]] Function function;
+  [[no_unique_address]] storage_type stored;
+};
+
+// curry() without the copies: each argument is moved (or copied, from an
+// lvalue) into flat storage once, rvalue partial applications move rather
+// than copy what they hold, and std::reference_wrapper arguments are passed
+// on as references. Once the arguments suffice it is a plain std::invoke.
+template<typename Function, typename... Ps> constexpr decltype(auto) flat_curry(Function &&func, Ps &&...ps)
+{
+  return curried<std::decay_t<Function>>{ std::in_place, std::forward<Function>(func) }(std::forward<Ps>(ps)...);
+}
 }// namespace lefticus::tools
+
+#endif// LEFTICUS_TOOLS_CURRY_HPP
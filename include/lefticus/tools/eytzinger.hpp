@@ -0,0 +1,125 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_EYTZINGER_HPP
+#define LEFTICUS_TOOLS_EYTZINGER_HPP
+
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace lefticus::tools {
+
+// Eytzinger (BFS) layout of a sorted sequence: the element at 1-based
+// index k has children at 2k and 2k+1. A search then touches memory
+// top-down in the order it is laid out, instead of jumping around the
+// way binary search over a sorted array does.
+//
+// Element k is stored at offset k-1, so there is no wasted first slot.
+
+namespace detail {
+  template<typename InputItr, typename OutputItr>
+  // NOLINTNEXTLINE(misc-no-recursion)
+  constexpr void eytzinger_fill(InputItr &sorted, OutputItr out, const std::size_t size, const std::size_t k)
+  {
+    if (k > size) { return; }
+    eytzinger_fill(sorted, out, size, 2 * k);
+    *std::next(out, static_cast<std::ptrdiff_t>(k - 1)) = *sorted;
+    ++sorted;
+    eytzinger_fill(sorted, out, size, 2 * k + 1);
+  }
+
+  inline void prefetch([[maybe_unused]] const void *address) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#endif
+  }
+}// namespace detail
+
+// copies the sorted range [begin, end) into `out` in Eytzinger order,
+// `out` must be random access and have room for `end - begin` elements
+template<typename InputItr, typename OutputItr>
+constexpr void to_eytzinger(InputItr begin, InputItr end, OutputItr out)
+{
+  const auto size = static_cast<std::size_t>(std::distance(begin, end));
+  detail::eytzinger_fill(begin, out, size, 1);
+}
+
+// returns the offset of the first element not less than `key`, or `size(range)`
+// if there is none. `range` must already be in Eytzinger order.
+//
+// The descent is branchless, and for contiguous ranges the cache line
+// holding the descendants four levels down is prefetched at each step.
+template<typename Range, typename Key, typename Projection = std::identity>
+[[nodiscard]] constexpr std::size_t eytzinger_lower_bound(const Range &range, const Key &key, Projection proj = {})
+{
+  const std::size_t size = std::size(range);
+  const auto data = std::begin(range);
+
+  // The 16 great-great-grandchildren of k are elements 16k to 16k+15, at
+  // offsets 16k-1 to 16k+14. With 4 byte keys in a 64 byte aligned array
+  // the line starting at offset 16k holds all but the first of them.
+  constexpr std::size_t prefetch_distance = 16;
+
+  std::size_t k = 1;
+  while (k <= size) {
+    if constexpr (std::contiguous_iterator<std::remove_const_t<decltype(data)>>) {
+      // near the bottom there is nothing left worth prefetching
+      if (!std::is_constant_evaluated() && prefetch_distance * k < size) {
+        detail::prefetch(std::to_address(data) + prefetch_distance * k);
+      }
+    }
+
+    const bool go_right = std::invoke(proj, *std::next(data, static_cast<std::ptrdiff_t>(k - 1))) < key;
+    k = 2 * k + static_cast<std::size_t>(go_right);
+  }
+
+  // strip off the trailing right turns, plus the final left turn
+  k >>= std::countr_one(k) + 1;
+
+  return k == 0 ? size : k - 1;
+}
+
+// returns an iterator to the element matching `key`, or `end(range)`
+template<typename Range, typename Key, typename Projection = std::identity>
+[[nodiscard]] constexpr auto eytzinger_find(const Range &range, const Key &key, Projection proj = {})
+{
+  const auto offset = eytzinger_lower_bound(range, key, proj);
+  const auto found = std::next(std::begin(range), static_cast<std::ptrdiff_t>(offset));
+  if (found != std::end(range) && std::invoke(proj, *found) == key) { return found; }
+  return std::end(range);
+}
+
+}// namespace lefticus::tools
+
+#endif// LEFTICUS_TOOLS_EYTZINGER_HPP
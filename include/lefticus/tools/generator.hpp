@@ -0,0 +1,387 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_GENERATOR_HPP
+#define LEFTICUS_TOOLS_GENERATOR_HPP
+
+#include "simple_stack_vector.hpp"
+
+#include <array>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace lefticus::tools::lambda_coroutines {
+
+inline constexpr std::size_t frame_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+// Caller-provided storage for up to Capacity coroutine frames of at most
+// BlockSize bytes each, counting a 16 byte header. Blocks are handed out
+// from a simple_stack_vector and recycled through a free list, so it never
+// allocates. Pass it to a generator coroutine as `std::allocator_arg,
+// storage` leading arguments. It is not synchronized: its generators must
+// be destroyed on the thread that owns it, and before it is.
+template<std::size_t BlockSize, std::size_t Capacity> class frame_storage
+{
+  struct alignas(frame_alignment) block
+  {
+    std::array<std::byte, BlockSize> bytes;
+  };
+
+public:
+  static constexpr std::size_t block_size = BlockSize;
+
+  [[nodiscard]] void *allocate(const std::size_t size)
+  {
+    if (size > BlockSize) { throw std::bad_alloc{}; }
+    if (free_head != nullptr) {
+      return std::exchange(free_head, free_head->next);
+    }
+    if (blocks.size() == Capacity) { throw std::bad_alloc{}; }
+    return blocks.emplace_back().bytes.data();
+  }
+
+  void deallocate(void *frame, [[maybe_unused]] const std::size_t size) noexcept
+  {
+    free_head = ::new (frame) free_block{ free_head };
+  }
+
+private:
+  struct free_block
+  {
+    free_block *next;
+  };
+  static_assert(BlockSize >= sizeof(free_block));
+
+  simple_stack_vector<block, Capacity> blocks;
+  free_block *free_head = nullptr;
+};
+
+// Per-thread cache of freed coroutine frames, in 64 byte size classes up
+// to 2KiB. Creating a generator after one of the same size class was
+// destroyed on the same thread reuses its frame instead of calling
+// operator new. Larger frames always use the heap. Every block comes from
+// ::operator new rounded up to its size class, so a generator destroyed on
+// another thread simply hands its frame to that thread's cache.
+class frame_cache
+{
+public:
+  static constexpr std::size_t class_size = 64;
+  static constexpr std::size_t class_count = 32;
+  // the most frames kept per size class, beyond this they are freed
+  static constexpr std::size_t class_limit = 64;
+
+  frame_cache() = default;
+  frame_cache(const frame_cache &) = delete;
+  frame_cache(frame_cache &&) = delete;
+  frame_cache &operator=(const frame_cache &) = delete;
+  frame_cache &operator=(frame_cache &&) = delete;
+
+  ~frame_cache()
+  {
+    for (std::size_t size_class = 0; size_class < class_count; ++size_class) {
+      while (free_lists[size_class] != nullptr) {
+        ::operator delete(std::exchange(free_lists[size_class], free_lists[size_class]->next), bytes(size_class));
+      }
+    }
+  }
+
+  [[nodiscard]] static frame_cache &local() noexcept
+  {
+    static thread_local frame_cache cache;
+    return cache;
+  }
+
+  [[nodiscard]] void *allocate(const std::size_t size)
+  {
+    const auto size_class = class_of(size);
+    if (size_class >= class_count) { return ::operator new(size); }
+    if (free_lists[size_class] != nullptr) {
+      --counts[size_class];
+      return std::exchange(free_lists[size_class], free_lists[size_class]->next);
+    }
+    return ::operator new(bytes(size_class));
+  }
+
+  void deallocate(void *frame, const std::size_t size) noexcept
+  {
+    const auto size_class = class_of(size);
+    if (size_class >= class_count) {
+      ::operator delete(frame, size);
+    } else if (counts[size_class] == class_limit) {
+      ::operator delete(frame, bytes(size_class));
+    } else {
+      ++counts[size_class];
+      free_lists[size_class] = ::new (frame) free_block{ free_lists[size_class] };
+    }
+  }
+
+  // frames waiting to be reused
+  [[nodiscard]] std::size_t cached() const noexcept
+  {
+    std::size_t total = 0;
+    for (const auto count : counts) { total += count; }
+    return total;
+  }
+
+private:
+  struct free_block
+  {
+    free_block *next;
+  };
+
+  [[nodiscard]] static constexpr std::size_t class_of(const std::size_t size) noexcept
+  {
+    return (size + class_size - 1) / class_size - 1;
+  }
+  [[nodiscard]] static constexpr std::size_t bytes(const std::size_t size_class) noexcept
+  {
+    return (size_class + 1) * class_size;
+  }
+
+  std::array<free_block *, class_count> free_lists{};
+  std::array<std::size_t, class_count> counts{};
+};
+
+namespace detail {
+  // placed in front of every frame to record where it has to go back to
+  struct alignas(frame_alignment) frame_header
+  {
+    void (*release)(void *source, void *block, std::size_t size) noexcept;
+    void *source;
+  };
+
+  template<typename Source> [[nodiscard]] void *allocate_frame(Source &source, const std::size_t size)
+  {
+    const auto total = size + sizeof(frame_header);
+    void *block = source.allocate(total);
+    auto *header = ::new (block) frame_header{
+      [](void *owner, void *freed, const std::size_t freed_size) noexcept {
+        static_cast<Source *>(owner)->deallocate(freed, freed_size);
+      },
+      std::addressof(source)
+    };
+    return header + 1;
+  }
+
+  // never remembers the allocating thread's cache, which may be in use by
+  // that thread or already destroyed with it when the frame is freed
+  [[nodiscard]] inline void *allocate_cached_frame(const std::size_t size)
+  {
+    void *block = frame_cache::local().allocate(size + sizeof(frame_header));
+    auto *header = ::new (block) frame_header{
+      [](void *, void *freed, const std::size_t freed_size) noexcept {
+        frame_cache::local().deallocate(freed, freed_size);
+      },
+      nullptr
+    };
+    return header + 1;
+  }
+
+  inline void deallocate_frame(void *frame, const std::size_t size) noexcept
+  {
+    auto *header = static_cast<frame_header *>(frame) - 1;
+    header->release(header->source, header, size + sizeof(frame_header));
+  }
+}// namespace detail
+
+template<typename Storage>
+concept frame_source = requires(Storage &storage, void *frame, std::size_t size) {
+  {
+    storage.allocate(size)
+  } -> std::same_as<void *>;
+  storage.deallocate(frame, size);
+};
+
+// A C++20 coroutine generator whose frames come from frame_cache::local(),
+// or from a frame_source passed as `std::allocator_arg, source` leading
+// arguments. Like the lambda_coroutines ranges it is iterated with a range
+// for, and calling it returns the next value or nullopt when it is done,
+// so it can be handed to while_has_value.
+template<typename Value> class generator
+{
+public:
+  using value_type = std::remove_cvref_t<Value>;
+  using reference = const value_type &;
+
+  // everything but where the frame comes from
+  struct promise_base
+  {
+    const value_type *current = nullptr;
+    std::exception_ptr failure;
+
+    [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+    [[nodiscard]] std::suspend_always final_suspend() const noexcept { return {}; }
+
+    // the yielded object outlives the suspension, so only its address is kept
+    std::suspend_always yield_value(const value_type &value) noexcept
+    {
+      current = std::addressof(value);
+      return {};
+    }
+
+    void return_void() const noexcept {}
+    void unhandled_exception() noexcept { failure = std::current_exception(); }
+
+    // generators only co_yield
+    void await_transform() = delete;
+  };
+
+  struct promise_type : promise_base
+  {
+    [[nodiscard]] static void *operator new(const std::size_t size) { return detail::allocate_cached_frame(size); }
+
+    static void operator delete(void *frame, const std::size_t size) noexcept
+    {
+      detail::deallocate_frame(frame, size);
+    }
+
+    [[nodiscard]] generator get_return_object() noexcept
+    {
+      return generator{ std::coroutine_handle<promise_type>::from_promise(*this) };
+    }
+  };
+
+  // Picked by the std::coroutine_traits specialization below for coroutines
+  // taking `std::allocator_arg, source` leading arguments. Its operator new
+  // has their exact parameters instead of being a template, which GCC
+  // reports as mismatched with operator delete.
+  template<frame_source Source, typename... Param> struct source_promise : promise_base
+  {
+    [[nodiscard]] static void *
+      operator new(const std::size_t size, std::allocator_arg_t, Source &source, const Param &...)
+    {
+      return detail::allocate_frame(source, size);
+    }
+
+    static void operator delete(void *frame, const std::size_t size) noexcept
+    {
+      detail::deallocate_frame(frame, size);
+    }
+
+    [[nodiscard]] generator get_return_object() noexcept
+    {
+      return generator{ std::coroutine_handle<source_promise>::from_promise(*this) };
+    }
+  };
+
+  struct iterator
+  {
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = generator::value_type;
+    using difference_type = std::ptrdiff_t;
+
+    std::coroutine_handle<> coroutine;
+    promise_base *promise;
+
+    [[nodiscard]] reference operator*() const noexcept { return *promise->current; }
+
+    iterator &operator++()
+    {
+      generator::advance(coroutine, *promise);
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept { return coroutine.done(); }
+  };
+
+  generator() = default;
+  generator(const generator &) = delete;
+  generator &operator=(const generator &) = delete;
+  generator(generator &&other) noexcept
+    : coroutine{ std::exchange(other.coroutine, nullptr) }, promise{ std::exchange(other.promise, nullptr) }
+  {}
+  generator &operator=(generator &&other) noexcept
+  {
+    std::swap(coroutine, other.coroutine);
+    std::swap(promise, other.promise);
+    return *this;
+  }
+  ~generator()
+  {
+    if (coroutine) { coroutine.destroy(); }
+  }
+
+  // resumes to the first value, so only call it once
+  [[nodiscard]] iterator begin()
+  {
+    advance(coroutine, *promise);
+    return iterator{ coroutine, promise };
+  }
+
+  [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+  // the next value, or nullopt once the coroutine has returned
+  [[nodiscard]] std::optional<value_type> operator()()
+  {
+    if (coroutine.done()) { return std::nullopt; }
+    advance(coroutine, *promise);
+    if (coroutine.done()) { return std::nullopt; }
+    return *promise->current;
+  }
+
+private:
+  template<typename Promise>
+  explicit generator(const std::coroutine_handle<Promise> handle) noexcept
+    : coroutine{ handle }, promise{ std::addressof(handle.promise()) }
+  {}
+
+  static void advance(const std::coroutine_handle<> handle, promise_base &state)
+  {
+    handle.resume();
+    if (auto &failure = state.failure) { std::rethrow_exception(std::exchange(failure, nullptr)); }
+  }
+
+  std::coroutine_handle<> coroutine{};
+  promise_base *promise = nullptr;
+};
+
+}// namespace lefticus::tools::lambda_coroutines
+
+template<typename Value, lefticus::tools::lambda_coroutines::frame_source Source, typename... Param>
+struct std::coroutine_traits<lefticus::tools::lambda_coroutines::generator<Value>,
+  std::allocator_arg_t,
+  Source &,
+  Param...>
+{
+  using promise_type =
+    typename lefticus::tools::lambda_coroutines::generator<Value>::template source_promise<Source, Param...>;
+};
+
+#endif// LEFTICUS_TOOLS_GENERATOR_HPP
@@ -0,0 +1,308 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_HASH_HPP
+#define LEFTICUS_TOOLS_HASH_HPP
+
+#include "non_promoting_ints.hpp"
+#include "non_promoting_wide_ints.hpp"
+#include "simple_stack_string.hpp"
+#include "strong_types.hpp"
+#include "utility.hpp"
+
+#include <array>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// A rapidhash style hash: every step is a 64 x 64 -> 128 bit multiply whose
+// halves are folded together. Bytes are always read little-endian so results
+// are the same at compile time, at run time and across platforms.
+
+namespace lefticus::tools {
+namespace detail {
+  inline constexpr std::array<std::uint64_t, 3> hash_secret{
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL
+  };
+
+  [[nodiscard]] constexpr std::uint64_t hash_mix(const std::uint64_t lhs, const std::uint64_t rhs) noexcept
+  {
+    const auto product = multiply_wide(lhs, rhs);
+    return product.low ^ product.high;
+  }
+
+  // `count` bytes starting at byte `offset` of the object representation of `chars`
+  template<typename CharType>
+  [[nodiscard]] constexpr std::uint64_t read_bytes(const CharType *chars,
+    const std::size_t offset,
+    const std::size_t count) noexcept
+  {
+    if (!std::is_constant_evaluated() && std::endian::native == std::endian::little && (count == 4 || count == 8)) {
+      // the loop below is not folded into a single load
+      const auto *bytes = reinterpret_cast<const unsigned char *>(chars) + offset;// NOLINT reinterpret_cast
+      if (count == 4) {
+        std::uint32_t word = 0;
+        std::memcpy(&word, bytes, sizeof(word));
+        return word;
+      }
+      std::uint64_t word = 0;
+      std::memcpy(&word, bytes, sizeof(word));
+      return word;
+    }
+
+    std::uint64_t result = 0;
+    for (std::size_t byte = 0; byte < count; ++byte) {
+      const auto index = offset + byte;
+      const auto unit =
+        static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<CharType>>(chars[index / sizeof(CharType)]));
+      const auto value = (unit >> (CHAR_BIT * (index % sizeof(CharType)))) & 0xFFU;// NOLINT Magic Number
+      result |= value << (CHAR_BIT * byte);
+    }
+    return result;
+  }
+}// namespace detail
+
+inline constexpr std::uint64_t default_hash_seed = 0;
+
+// hashes `length` characters as their object representation
+template<typename CharType>
+[[nodiscard]] constexpr std::uint64_t
+  hash_chars(const CharType *chars, const std::size_t length, std::uint64_t seed = default_hash_seed) noexcept
+{
+  using detail::hash_mix;
+  using detail::hash_secret;
+  using detail::read_bytes;
+
+  const std::uint64_t bytes = length * sizeof(CharType);
+  seed ^= hash_mix(seed ^ hash_secret[0], hash_secret[1]) ^ bytes;
+
+  std::uint64_t lhs = 0;
+  std::uint64_t rhs = 0;
+  if (bytes <= 16) {// NOLINT Magic Number
+    if (bytes >= 4) {
+      // two overlapping reads from each end cover 4 to 16 bytes
+      const std::size_t last = bytes - 4;
+      const std::size_t delta = (bytes & 24U) >> (bytes >> 3U);// NOLINT Magic Number
+      lhs = (read_bytes(chars, 0, 4) << 32U) | read_bytes(chars, last, 4);// NOLINT Magic Number
+      rhs = (read_bytes(chars, delta, 4) << 32U) | read_bytes(chars, last - delta, 4);// NOLINT Magic Number
+    } else if (bytes > 0) {
+      lhs = (read_bytes(chars, 0, 1) << 56U) | (read_bytes(chars, bytes >> 1U, 1) << 32U)// NOLINT Magic Number
+            | read_bytes(chars, bytes - 1, 1);
+    }
+  } else {
+    std::size_t offset = 0;
+    std::size_t remaining = bytes;
+    if (remaining > 48) {// NOLINT Magic Number
+      // three independent lanes keep the multipliers busy
+      std::uint64_t lane1 = seed;
+      std::uint64_t lane2 = seed;
+      while (remaining >= 48) {// NOLINT Magic Number
+        seed = hash_mix(read_bytes(chars, offset, 8) ^ hash_secret[0], read_bytes(chars, offset + 8, 8) ^ seed);
+        lane1 = hash_mix(read_bytes(chars, offset + 16, 8) ^ hash_secret[1], read_bytes(chars, offset + 24, 8) ^ lane1);
+        lane2 = hash_mix(read_bytes(chars, offset + 32, 8) ^ hash_secret[2], read_bytes(chars, offset + 40, 8) ^ lane2);
+        offset += 48;// NOLINT Magic Number
+        remaining -= 48;// NOLINT Magic Number
+      }
+      seed ^= lane1 ^ lane2;
+    }
+    if (remaining > 16) {// NOLINT Magic Number
+      seed = hash_mix(
+        read_bytes(chars, offset, 8) ^ hash_secret[2], read_bytes(chars, offset + 8, 8) ^ seed ^ hash_secret[1]);
+      if (remaining > 32) {// NOLINT Magic Number
+        seed = hash_mix(read_bytes(chars, offset + 16, 8) ^ hash_secret[2], read_bytes(chars, offset + 24, 8) ^ seed);
+      }
+    }
+    // the final 16 bytes, overlapping what was already consumed
+    lhs = read_bytes(chars, offset + remaining - 16, 8);// NOLINT Magic Number
+    rhs = read_bytes(chars, offset + remaining - 8, 8);
+  }
+
+  const auto product = detail::multiply_wide(lhs ^ hash_secret[1], rhs ^ seed);
+  return hash_mix(product.low ^ hash_secret[0] ^ bytes, product.high ^ hash_secret[1]);
+}
+
+// hash_value overloads. Each takes the seed to continue from, so composite
+// values hash their members in order by threading the result through.
+
+template<typename Value>
+  requires(std::integral<Value> || std::is_enum_v<Value>)
+[[nodiscard]] constexpr std::uint64_t hash_value(const Value value,
+  const std::uint64_t seed = default_hash_seed) noexcept
+{
+  std::uint64_t bits = 0;
+  if constexpr (std::is_same_v<Value, bool>) {
+    bits = value ? 1U : 0U;
+  } else if constexpr (std::is_enum_v<Value>) {
+    bits = static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<std::underlying_type_t<Value>>>(value));
+  } else {
+    bits = static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<Value>>(value));
+  }
+  return detail::hash_mix(bits ^ detail::hash_secret[0], seed ^ detail::hash_secret[1]);
+}
+
+template<std::floating_point Value>
+  requires(sizeof(Value) <= sizeof(std::uint64_t))
+[[nodiscard]] constexpr std::uint64_t hash_value(const Value value,
+  const std::uint64_t seed = default_hash_seed) noexcept
+{
+  // -0.0 == 0.0, so they must hash the same
+  using bits_type = std::conditional_t<sizeof(Value) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+  return hash_value(value == Value{} ? bits_type{} : std::bit_cast<bits_type>(value), seed);
+}
+
+template<typename CharType, typename Traits>
+[[nodiscard]] constexpr std::uint64_t hash_value(const std::basic_string_view<CharType, Traits> value,
+  const std::uint64_t seed = default_hash_seed) noexcept
+{
+  return hash_chars(value.data(), value.size(), seed);
+}
+
+template<typename CharType, typename Traits, typename Allocator>
+[[nodiscard]] constexpr std::uint64_t hash_value(const std::basic_string<CharType, Traits, Allocator> &value,
+  const std::uint64_t seed = default_hash_seed) noexcept
+{
+  return hash_chars(value.data(), value.size(), seed);
+}
+
+template<typename CharType, std::size_t TotalCapacity, typename Traits>
+[[nodiscard]] constexpr std::uint64_t hash_value(
+  const basic_simple_stack_string<CharType, TotalCapacity, Traits> &value,
+  const std::uint64_t seed = default_hash_seed) noexcept
+{
+  return hash_chars(value.data(), value.size(), seed);
+}
+
+// the same as the underlying integer, whatever the overflow policy
+template<std::integral Type, typename Overflow>
+[[nodiscard]] constexpr std::uint64_t hash_value(const int_np<Type, Overflow> value,
+  const std::uint64_t seed = default_hash_seed) noexcept
+{
+  return hash_value(value.get(), seed);
+}
+
+template<std::size_t Bits>
+[[nodiscard]] constexpr std::uint64_t hash_value(const uint_np<Bits> &value,
+  const std::uint64_t seed = default_hash_seed) noexcept
+{
+  return hash_chars(value.words().data(), value.words().size(), seed);
+}
+
+template<typename Underlying, typename Tag, auto Validator>
+  requires requires(const Underlying &value) { hash_value(value, default_hash_seed); }
+[[nodiscard]] constexpr std::uint64_t hash_value(const strong_alias<Underlying, Tag, Validator> &value,
+  const std::uint64_t seed = default_hash_seed) noexcept(noexcept(hash_value(value.get(), seed)))
+{
+  return hash_value(value.get(), seed);
+}
+
+template<typename First, typename Second>
+  requires requires(const First &first, const Second &second) {
+    hash_value(first, default_hash_seed);
+    hash_value(second, default_hash_seed);
+  }
+[[nodiscard]] constexpr std::uint64_t hash_value(const std::pair<First, Second> &value,
+  const std::uint64_t seed = default_hash_seed) noexcept(noexcept(hash_value(value.first, seed))
+                                                           && noexcept(hash_value(value.second, seed)))
+{
+  return hash_value(value.second, hash_value(value.first, seed));
+}
+
+// the same as the matching std::pair
+template<typename First, typename Second>
+  requires requires(const First &first, const Second &second) {
+    hash_value(first, default_hash_seed);
+    hash_value(second, default_hash_seed);
+  }
+[[nodiscard]] constexpr std::uint64_t hash_value(const pair<First, Second> &value,
+  const std::uint64_t seed = default_hash_seed) noexcept(noexcept(hash_value(value.first, seed))
+                                                           && noexcept(hash_value(value.second, seed)))
+{
+  return hash_value(value.second, hash_value(value.first, seed));
+}
+
+// declared after every hash_value overload above so that it sees all of them
+template<typename Value>
+concept hashable = requires(const Value &value, std::uint64_t seed) {
+  {
+    hash_value(value, seed)
+  } -> std::same_as<std::uint64_t>;
+};
+
+// A drop-in for std::hash, for keys std::hash does not cover such as std::pair
+template<typename Key> struct hash
+{
+  [[nodiscard]] constexpr std::size_t operator()(const Key &key) const noexcept(noexcept(hash_value(key)))
+    requires hashable<Key>
+  {
+    return static_cast<std::size_t>(hash_value(key));
+  }
+};
+
+}// namespace lefticus::tools
+
+template<typename Underlying, typename Tag, auto Validator>
+  requires lefticus::tools::hashable<Underlying>
+struct std::hash<lefticus::tools::strong_alias<Underlying, Tag, Validator>>
+  : lefticus::tools::hash<lefticus::tools::strong_alias<Underlying, Tag, Validator>>
+{
+};
+
+template<std::integral Type, typename Overflow>
+struct std::hash<lefticus::tools::int_np<Type, Overflow>>
+  : lefticus::tools::hash<lefticus::tools::int_np<Type, Overflow>>
+{
+};
+
+template<std::size_t Bits>
+  requires(Bits >= 128 && Bits % 64 == 0)
+struct std::hash<lefticus::tools::uint_np<Bits>> : lefticus::tools::hash<lefticus::tools::uint_np<Bits>>
+{
+};
+
+template<typename CharType, std::size_t TotalCapacity, typename Traits>
+struct std::hash<lefticus::tools::basic_simple_stack_string<CharType, TotalCapacity, Traits>>
+  : lefticus::tools::hash<lefticus::tools::basic_simple_stack_string<CharType, TotalCapacity, Traits>>
+{
+};
+
+template<typename First, typename Second>
+  requires lefticus::tools::hashable<lefticus::tools::pair<First, Second>>
+struct std::hash<lefticus::tools::pair<First, Second>> : lefticus::tools::hash<lefticus::tools::pair<First, Second>>
+{
+};
+
+#endif// LEFTICUS_TOOLS_HASH_HPP
@@ -29,9 +29,13 @@ For more information, please refer to <https://unlicense.org>
 #ifndef LAMBDA_COROUTINES_HPP
 #define LAMBDA_COROUTINES_HPP
 
+#include "simple_stack_vector.hpp"
+
 #include <cstddef>
 #include <functional>
+#include <iterator>
 #include <optional>
+#include <type_traits>
 #include <utility>
 
 // because these are macros we cannot meaningfully use namespaces
@@ -70,78 +74,231 @@ template<typename ParamType> constexpr void lambda_co_status_check(ParamType &va
 
 #define lambda_co_end() }
 
-template<typename Lambda>
-[[nodiscard]] constexpr auto
-  range(Lambda lambda, std::size_t skip_ = 0, std::optional<std::size_t> length_ = {}, std::size_t stride_ = 1)
+namespace detail {
+  // Holds a Contained that may not be assignable, as lambdas with captures
+  // are not. Assignment destroys and reconstructs instead.
+  template<typename Contained> struct movable_box
+  {
+    std::optional<Contained> value;
+
+    constexpr movable_box() = default;
+    constexpr explicit movable_box(Contained contained) : value{ std::move(contained) } {}
+    constexpr movable_box(const movable_box &other) = default;
+    constexpr movable_box(movable_box &&other) = default;
+
+    constexpr movable_box &operator=(const movable_box &other)
+    {
+      if (this != &other) { rebind(other.value); }
+      return *this;
+    }
+
+    constexpr movable_box &operator=(movable_box &&other) noexcept(std::is_nothrow_move_constructible_v<Contained>)
+    {
+      if (this != &other) { rebind(std::move(other.value)); }
+      return *this;
+    }
+
+    [[nodiscard]] constexpr Contained &operator*() noexcept { return *value; }
+    [[nodiscard]] constexpr const Contained &operator*() const noexcept { return *value; }
+
+  private:
+    template<typename Other> constexpr void rebind(Other &&other)
+    {
+      value.reset();
+      if (other) { value.emplace(*std::forward<Other>(other)); }
+    }
+  };
+}// namespace detail
+
+template<typename Range, std::size_t Size> class lambda_chunk_range;
+
+// An input range over the values a lambda coroutine yields. Each value is
+// pulled once and cached, so dereferencing has no side effects and the
+// range works with std::ranges algorithms and std::views.
+template<typename Lambda> class lambda_range
 {
-  struct Range
+public:
+  using value_type = std::remove_cvref_t<std::invoke_result_t<Lambda &>>;
+
+  class iterator
   {
-    Lambda generator;
-    std::optional<std::size_t> length;
-    std::size_t stride;
-    std::size_t position = 0;
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = lambda_range::value_type;
+    using difference_type = std::ptrdiff_t;
 
-    struct Iterator
+    constexpr iterator() = default;
+
+    [[nodiscard]] constexpr const value_type &operator*() const noexcept { return *parent->current; }
+
+    constexpr iterator &operator++()
     {
-      std::reference_wrapper<Lambda> lambda;
-      std::reference_wrapper<std::size_t> position;
-      std::optional<std::size_t> length;
-      std::size_t stride = 1;
-      bool is_end = false;
+      parent->advance();
+      return *this;
+    }
 
-      [[nodiscard]] constexpr bool has_more() const noexcept
-      {
-        if (length && (position.get() >= length.value())) { return false; }
+    constexpr void operator++(int) { ++*this; }
+
+    [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept
+    {
+      return !parent->current.has_value();
+    }
+
+  private:
+    friend lambda_range;
+    constexpr explicit iterator(lambda_range *parent_) noexcept : parent{ parent_ } {}
+
+    lambda_range *parent = nullptr;
+  };
+
+  constexpr lambda_range(Lambda lambda, const std::optional<std::size_t> length_, const std::size_t stride_)
+    : generator{ std::move(lambda) }, length{ length_ }, stride{ stride_ }
+  {}
+
+  // the first call pulls the first value; later calls continue from where iteration stopped
+  [[nodiscard]] constexpr iterator begin()
+  {
+    start();
+    return iterator{ this };
+  }
+
+  [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return {}; }
+
+  // a range of simple_stack_vector batches of up to Size values each
+  template<std::size_t Size> [[nodiscard]] constexpr auto chunk() &
+  {
+    return lambda_chunk_range<lambda_range &, Size>{ *this };
+  }
+
+  template<std::size_t Size> [[nodiscard]] constexpr auto chunk() &&
+  {
+    return lambda_chunk_range<lambda_range, Size>{ std::move(*this) };
+  }
 
+  // refills `batch` with up to Size values in one tight loop, returning false if there were none left
+  template<std::size_t Size> constexpr bool pull(simple_stack_vector<value_type, Size> &batch)
+  {
+    start();
+    batch.clear();
+    if (!current) { return false; }
+
+    batch.push_back(std::move(*current));
+    while (batch.size() < Size) {
+      if (!skip_stride()) {
+        current.reset();
         return true;
       }
+      ++position;
+      batch.push_back((*generator)());
+    }
+    advance();
+    return true;
+  }
 
-      constexpr bool increment_position()
-      {
-        if (has_more()) {
-          ++position.get();
-          return true;
-        } else {
-          return false;
-        }
-      }
+private:
+  [[nodiscard]] constexpr bool has_more() const noexcept { return !length || position < *length; }
 
-      constexpr auto &operator++()
-      {
-        for (std::size_t i = 1; i < stride; ++i) {
-          if (increment_position()) { lambda(); }
-        }
-        return *this;
-      }
+  constexpr void start()
+  {
+    if (!started) {
+      started = true;
+      fetch();
+    }
+  }
 
-      constexpr bool operator==(const Iterator &rhs) const
-      {
-        // return false;
-        if (is_end && !rhs.has_more()) { return true; }
-        if (rhs.is_end && !has_more()) { return true; }
-        if (rhs.is_end && is_end) { return true; }
+  constexpr void fetch()
+  {
+    if (has_more()) {
+      ++position;
+      current.emplace((*generator)());
+    } else {
+      current.reset();
+    }
+  }
+
+  // discards the values between kept ones, returning whether another can be kept
+  constexpr bool skip_stride()
+  {
+    for (std::size_t skipped = 1; skipped < stride && has_more(); ++skipped) {
+      ++position;
+      (*generator)();
+    }
+    return has_more();
+  }
+
+  constexpr void advance()
+  {
+    skip_stride();
+    fetch();
+  }
+
+  detail::movable_box<Lambda> generator;
+  std::optional<std::size_t> length;
+  std::size_t stride;
+  std::size_t position = 0;
+  bool started = false;
+  std::optional<value_type> current;
+};
+
+// Batches of values pulled from a lambda_range, which is owned or, if
+// Range is a reference, borrowed
+template<typename Range, std::size_t Size> class lambda_chunk_range
+{
+public:
+  using batch_type = simple_stack_vector<typename std::remove_cvref_t<Range>::value_type, Size>;
 
-        return false;
-      }
+  class iterator
+  {
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = batch_type;
+    using difference_type = std::ptrdiff_t;
 
-      constexpr bool operator!=(const Iterator &rhs) const { return !(*this == rhs); }
+    constexpr iterator() = default;
 
-      [[nodiscard]] constexpr decltype(auto) operator*()
-      {
-        increment_position();
-        return lambda();
-      }
-    };
+    [[nodiscard]] constexpr const batch_type &operator*() const noexcept { return parent->batch; }
 
-    // cppcheck-suppress functionConst
-    [[nodiscard]] constexpr auto begin() noexcept { return Iterator{ generator, position, length, stride, false }; }
+    constexpr iterator &operator++()
+    {
+      parent->source.pull(parent->batch);
+      return *this;
+    }
 
-    // cppcheck-suppress functionConst
-    [[nodiscard]] constexpr auto end() noexcept { return Iterator{ generator, position, length, stride, true }; }
+    constexpr void operator++(int) { ++*this; }
+
+    [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept { return parent->batch.empty(); }
+
+  private:
+    friend lambda_chunk_range;
+    constexpr explicit iterator(lambda_chunk_range *parent_) noexcept : parent{ parent_ } {}
+
+    lambda_chunk_range *parent = nullptr;
   };
 
+  constexpr explicit lambda_chunk_range(Range source_) : source(std::forward<Range>(source_)) {}
+
+  [[nodiscard]] constexpr iterator begin()
+  {
+    source.pull(batch);
+    return iterator{ this };
+  }
+
+  [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+  Range source;
+  batch_type batch;
+};
+
+// Values from `lambda` after discarding the first `skip_`. `length_` limits
+// how many times the lambda is called after that, and only every
+// `stride_`th value is kept.
+template<typename Lambda>
+[[nodiscard]] constexpr auto
+  range(Lambda lambda, std::size_t skip_ = 0, std::optional<std::size_t> length_ = {}, std::size_t stride_ = 1)
+{
   for (std::size_t i = 0; i < skip_; ++i) { lambda(); }
-  return Range{ std::move(lambda), length_, stride_ };
+  return lambda_range<Lambda>{ std::move(lambda), length_, stride_ };
 }
 
 template<typename Lambda> [[nodiscard]] constexpr auto while_has_value(Lambda lambda)
@@ -0,0 +1,511 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_LAMBDA_IO_HPP
+#define LEFTICUS_TOOLS_LAMBDA_IO_HPP
+
+#include "lambda_scheduler.hpp"
+#include "simple_stack_vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace lefticus::tools::lambda_coroutines {
+
+enum struct io_interest : std::uint8_t { read = 1, write = 2 };
+
+// How an io_driver asks the kernel about file descriptor readiness
+enum struct io_backend : std::uint8_t { epoll, io_uring };
+
+struct io_handle
+{
+  std::uint32_t index{};
+  std::uint32_t generation{};
+
+  [[nodiscard]] constexpr bool operator==(const io_handle &) const noexcept = default;
+};
+
+namespace detail {
+  [[nodiscard]] inline std::uint64_t io_user_data(const std::uint32_t index,
+    const std::uint32_t generation,
+    const io_interest interest) noexcept
+  {
+    return (std::uint64_t{ generation } << 32U) | (std::uint64_t{ index } << 2U) | static_cast<std::uint8_t>(interest);
+  }
+
+  // A minimal io_uring, set up with the raw system calls so that no liburing
+  // is needed. Only one thread may use it.
+  class io_uring_ring
+  {
+  public:
+    // leaves the ring closed if the kernel or a seccomp policy refuses it
+    explicit io_uring_ring(const unsigned entries) noexcept
+    {
+      if (entries == 0) { return; }
+      io_uring_params params{};
+      const auto result = ::syscall(__NR_io_uring_setup, entries, &params);
+      if (result < 0) { return; }
+      ring_fd = static_cast<int>(result);
+
+      sq_size = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+      cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+      single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+      if (single_mmap) { sq_size = cq_size = std::max(sq_size, cq_size); }
+
+      sq_ring = map(sq_size, IORING_OFF_SQ_RING);
+      cq_ring = single_mmap ? sq_ring : map(cq_size, IORING_OFF_CQ_RING);
+      sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+      void *sqe_memory = map(sqes_size, IORING_OFF_SQES);
+      if (sq_ring == nullptr || cq_ring == nullptr || sqe_memory == nullptr) {
+        if (sqe_memory != nullptr) { ::munmap(sqe_memory, sqes_size); }
+        release();
+        return;
+      }
+
+      auto *const sq = static_cast<char *>(sq_ring);
+      sq_head = reinterpret_cast<unsigned *>(sq + params.sq_off.head);// NOLINT reinterpret_cast
+      sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);// NOLINT reinterpret_cast
+      sq_mask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);// NOLINT reinterpret_cast
+      sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);// NOLINT reinterpret_cast
+      sq_entries = params.sq_entries;
+      sqes = static_cast<io_uring_sqe *>(sqe_memory);
+
+      auto *const cq = static_cast<char *>(cq_ring);
+      cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);// NOLINT reinterpret_cast
+      cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);// NOLINT reinterpret_cast
+      cq_mask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);// NOLINT reinterpret_cast
+      cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);// NOLINT reinterpret_cast
+    }
+
+    io_uring_ring(const io_uring_ring &) = delete;
+    io_uring_ring &operator=(const io_uring_ring &) = delete;
+
+    ~io_uring_ring()
+    {
+      if (sqes != nullptr) { ::munmap(sqes, sqes_size); }
+      release();
+    }
+
+    [[nodiscard]] bool is_open() const noexcept { return sqes != nullptr; }
+
+    // the returned entry is zeroed and is submitted by the next enter()
+    [[nodiscard]] io_uring_sqe &next_sqe()
+    {
+      const auto tail = *sq_tail;
+      if (tail - std::atomic_ref<unsigned>{ *sq_head }.load(std::memory_order_acquire) == sq_entries) {
+        enter(0, 0);
+      }
+      const auto index = tail & sq_mask;
+      sqes[index] = io_uring_sqe{};// NOLINT pointer arithmetic
+      sq_array[index] = index;// NOLINT pointer arithmetic
+      std::atomic_ref<unsigned>{ *sq_tail }.store(tail + 1, std::memory_order_release);
+      ++unsubmitted;
+      return sqes[index];// NOLINT pointer arithmetic
+    }
+
+    // submits everything queued and waits for at least `min_complete` completions
+    void enter(const unsigned min_complete, const unsigned flags)
+    {
+      while (true) {
+        const auto result =
+          ::syscall(__NR_io_uring_enter, ring_fd, unsubmitted, min_complete, flags, nullptr, std::size_t{ 0 });
+        if (result >= 0) {
+          unsubmitted -= static_cast<unsigned>(result);
+          return;
+        }
+        if (errno != EINTR) { throw std::system_error(errno, std::generic_category(), "io_uring_enter failed"); }
+      }
+    }
+
+    // calls `handle(cqe)` for every completion that is waiting
+    template<typename Handler> std::size_t drain(Handler &&handle)
+    {
+      auto head = *cq_head;
+      const auto tail = std::atomic_ref<unsigned>{ *cq_tail }.load(std::memory_order_acquire);
+      const std::size_t count = tail - head;
+      for (; head != tail; ++head) { handle(cqes[head & cq_mask]); }// NOLINT pointer arithmetic
+      std::atomic_ref<unsigned>{ *cq_head }.store(head, std::memory_order_release);
+      return count;
+    }
+
+    [[nodiscard]] bool has_completions() const noexcept
+    {
+      return *cq_head != std::atomic_ref<unsigned>{ *cq_tail }.load(std::memory_order_acquire);
+    }
+
+  private:
+    [[nodiscard]] void *map(const std::size_t size, const long long offset) const noexcept
+    {
+      void *memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+      return memory == MAP_FAILED ? nullptr : memory;// NOLINT cast from MAP_FAILED
+    }
+
+    void release() noexcept
+    {
+      if (cq_ring != nullptr && !single_mmap) { ::munmap(cq_ring, cq_size); }
+      if (sq_ring != nullptr) { ::munmap(sq_ring, sq_size); }
+      if (ring_fd != -1) { ::close(ring_fd); }
+      sq_ring = cq_ring = nullptr;
+      sqes = nullptr;
+      ring_fd = -1;
+    }
+
+    int ring_fd = -1;
+    bool single_mmap = false;
+    void *sq_ring = nullptr;
+    void *cq_ring = nullptr;
+    std::size_t sq_size = 0;
+    std::size_t cq_size = 0;
+    std::size_t sqes_size = 0;
+
+    unsigned *sq_head = nullptr;
+    unsigned *sq_tail = nullptr;
+    unsigned *sq_array = nullptr;
+    unsigned sq_mask = 0;
+    unsigned sq_entries = 0;
+    unsigned unsubmitted = 0;
+    io_uring_sqe *sqes = nullptr;
+
+    unsigned *cq_head = nullptr;
+    unsigned *cq_tail = nullptr;
+    unsigned cq_mask = 0;
+    io_uring_cqe *cqes = nullptr;
+  };
+}// namespace detail
+
+// Suspends lambda coroutines on file descriptor readiness, so that one
+// scheduler thread can serve many connections. A task registers its fd with
+// watch() and then suspends with
+//
+//   lambda_co_yield(io.wait(handle, io_interest::read));
+//
+// Readiness is level triggered and one-shot: a task that is woken does its
+// read or write, on a non-blocking fd, and waits again if it gets EAGAIN.
+// The driver does not own the file descriptors, unwatch() them before closing.
+//
+// The driver does not depend on the task type, so tasks may capture it, and
+// it can serve any scheduler as long as every wait() is resumed by the same one.
+template<std::size_t MaxWatches> class io_driver
+{
+  static_assert(MaxWatches < (std::uint32_t{ 1 } << 30U), "watch indexes must fit in user data");
+
+  static constexpr std::uint32_t npos = wait_queue::npos;
+  static constexpr std::uint64_t timeout_user_data = std::numeric_limits<std::uint64_t>::max();
+  static constexpr std::size_t event_batch = 64;
+
+  struct watch_slot
+  {
+    int fd = -1;
+    wait_queue readable;
+    wait_queue writable;
+    // interests somebody is waiting for
+    std::uint8_t wanted = 0;
+    // interests the kernel is currently watching for
+    std::uint8_t armed = 0;
+    std::uint32_t next = npos;
+    // odd while the slot is watching an fd
+    std::uint32_t generation = 0;
+  };
+
+public:
+  // io_uring is used only if it is asked for and the kernel allows it
+  explicit io_driver(const io_backend preferred = io_backend::epoll)
+    : ring{ preferred == io_backend::io_uring ? uring_entries() : 0U }
+  {
+    if (ring.is_open()) {
+      active = io_backend::io_uring;
+    } else {
+      epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+      if (epoll_fd == -1) { throw std::system_error(errno, std::generic_category(), "epoll_create1 failed"); }
+    }
+  }
+
+  io_driver(const io_driver &) = delete;
+  io_driver &operator=(const io_driver &) = delete;
+
+  ~io_driver()
+  {
+    if (epoll_fd != -1) { ::close(epoll_fd); }
+  }
+
+  [[nodiscard]] static bool io_uring_supported() noexcept { return detail::io_uring_ring{ 1 }.is_open(); }
+
+  [[nodiscard]] io_backend backend() const noexcept { return active; }
+
+  // tasks suspended in wait() and not yet woken
+  [[nodiscard]] std::size_t waiting() const noexcept { return suspended; }
+
+  // starts tracking `fd`, which should be non-blocking
+  [[nodiscard]] io_handle watch(const int fd)
+  {
+    std::uint32_t index = free_head;
+    if (index == npos) {
+      if (slots.size() == MaxWatches) { throw std::length_error("io_driver is full"); }
+      index = static_cast<std::uint32_t>(slots.size());
+      slots.emplace_back();
+    } else {
+      free_head = slots[index].next;
+    }
+
+    auto &current = slots[index];
+    if (active == io_backend::epoll) {
+      // nothing is armed until somebody waits, but EPOLLERR and EPOLLHUP are always
+      // reported, and EPOLLONESHOT keeps even those from repeating
+      epoll_event event{};
+      event.events = EPOLLONESHOT;
+      event.data.u64 = detail::io_user_data(index, current.generation + 1, io_interest{});
+      if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        const auto error = errno;
+        current.next = free_head;
+        free_head = index;
+        throw std::system_error(error, std::generic_category(), "unable to watch file descriptor");
+      }
+    }
+
+    current.fd = fd;
+    current.wanted = 0;
+    current.armed = 0;
+    ++current.generation;
+    return io_handle{ index, current.generation };
+  }
+
+  // stops tracking the fd; no task may still be waiting on it
+  void unwatch(const io_handle handle)
+  {
+    auto &current = slot(handle);
+    if (!current.readable.empty() || !current.writable.empty()) {
+      throw std::logic_error("tasks are still waiting on this file descriptor");
+    }
+
+    if (active == io_backend::epoll) {
+      ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, current.fd, nullptr);
+    } else {
+      // cancelled polls complete later with a generation that no longer matches
+      for (const auto interest : { io_interest::read, io_interest::write }) {
+        if ((current.armed & static_cast<std::uint8_t>(interest)) != 0) {
+          auto &sqe = ring.next_sqe();
+          sqe.opcode = IORING_OP_POLL_REMOVE;
+          sqe.fd = -1;
+          sqe.addr = detail::io_user_data(handle.index, handle.generation, interest);
+          sqe.user_data = timeout_user_data;
+        }
+      }
+    }
+
+    current.fd = -1;
+    ++current.generation;
+    current.next = free_head;
+    free_head = handle.index;
+  }
+
+  // the step that suspends the calling task until the fd is ready for `interest`
+  [[nodiscard]] task_step wait(const io_handle handle, const io_interest interest)
+  {
+    auto &current = slot(handle);
+    const auto bit = static_cast<std::uint8_t>(interest);
+    current.wanted |= bit;
+    arm(handle.index, current);
+    ++suspended;
+    return task_step::wait(interest == io_interest::read ? current.readable : current.writable);
+  }
+
+  // waits up to `timeout_ms`, forever if negative, for any watched fd to become
+  // ready and makes the tasks waiting on it ready in `tasks`. Returns how many woke.
+  template<typename Scheduler> std::size_t poll(Scheduler &tasks, const int timeout_ms = -1)
+  {
+    if (active == io_backend::epoll) { return poll_epoll(tasks, timeout_ms); }
+    return poll_uring(tasks, timeout_ms);
+  }
+
+  // runs `tasks`, blocking for I/O whenever none are ready, until every task
+  // is done or nothing is left waiting on a file descriptor
+  template<typename Scheduler> void run(Scheduler &tasks)
+  {
+    while (true) {
+      tasks.run();
+      if (tasks.empty() || suspended == 0) { return; }
+      poll(tasks);
+    }
+  }
+
+private:
+  [[nodiscard]] static constexpr unsigned uring_entries() noexcept
+  {
+    // room for a read and a write poll per watch, plus cancellations and a timeout
+    return static_cast<unsigned>(std::bit_ceil(std::clamp<std::size_t>(MaxWatches * 2 + 2, 8, 4096)));
+  }
+
+  [[nodiscard]] watch_slot &slot(const io_handle handle)
+  {
+    if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation
+        || (handle.generation & 1U) == 0) {
+      throw std::invalid_argument("io_handle is not being watched");
+    }
+    return slots[handle.index];
+  }
+
+  void arm(const std::uint32_t index, watch_slot &current)
+  {
+    if (active == io_backend::epoll) {
+      if (current.armed == current.wanted) { return; }
+      epoll_event event{};
+      event.events = EPOLLONESHOT
+                     | ((current.wanted & static_cast<std::uint8_t>(io_interest::read)) != 0 ? EPOLLIN : 0U)
+                     | ((current.wanted & static_cast<std::uint8_t>(io_interest::write)) != 0 ? EPOLLOUT : 0U);
+      event.data.u64 = detail::io_user_data(index, current.generation, io_interest{});
+      if (::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, current.fd, &event) == -1) {
+        throw std::system_error(errno, std::generic_category(), "unable to arm file descriptor");
+      }
+      current.armed = current.wanted;
+      return;
+    }
+
+    // io_uring polls are one per interest, so arming one never disturbs the other
+    for (const auto interest : { io_interest::read, io_interest::write }) {
+      const auto bit = static_cast<std::uint8_t>(interest);
+      if ((current.wanted & bit) != 0 && (current.armed & bit) == 0) {
+        auto &sqe = ring.next_sqe();
+        sqe.opcode = IORING_OP_POLL_ADD;
+        sqe.fd = current.fd;
+        sqe.poll32_events = interest == io_interest::read ? POLLIN : POLLOUT;
+        sqe.user_data = detail::io_user_data(index, current.generation, interest);
+        current.armed |= bit;
+      }
+    }
+  }
+
+  // wakes the tasks waiting for `ready` on the slot named by `user_data`,
+  // ignoring events for slots that were unwatched since
+  template<typename Scheduler>
+  std::size_t wake(Scheduler &tasks, const std::uint64_t user_data, const std::uint8_t ready)
+  {
+    const auto index = static_cast<std::uint32_t>((user_data >> 2U) & 0x3fffffffU);
+    const auto generation = static_cast<std::uint32_t>(user_data >> 32U);
+    if (index >= slots.size() || slots[index].generation != generation) { return 0; }
+
+    auto &current = slots[index];
+    std::size_t woken = 0;
+    if ((ready & static_cast<std::uint8_t>(io_interest::read)) != 0) { woken += tasks.notify_all(current.readable); }
+    if ((ready & static_cast<std::uint8_t>(io_interest::write)) != 0) { woken += tasks.notify_all(current.writable); }
+    current.wanted &= static_cast<std::uint8_t>(~ready);
+    suspended -= woken;
+    return woken;
+  }
+
+  template<typename Scheduler> std::size_t poll_epoll(Scheduler &tasks, const int timeout_ms)
+  {
+    std::array<epoll_event, event_batch> events{};
+    int count = 0;
+    do {
+      count = ::epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), timeout_ms);
+    } while (count == -1 && errno == EINTR);
+    if (count == -1) { throw std::system_error(errno, std::generic_category(), "epoll_wait failed"); }
+
+    constexpr std::uint32_t read_events = EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR;
+    constexpr std::uint32_t write_events = EPOLLOUT | EPOLLHUP | EPOLLERR;
+
+    std::size_t woken = 0;
+    for (const auto &event : std::span{ events.data(), static_cast<std::size_t>(count) }) {
+      const auto ready = static_cast<std::uint8_t>(
+        ((event.events & read_events) != 0 ? static_cast<std::uint8_t>(io_interest::read) : 0U)
+        | ((event.events & write_events) != 0 ? static_cast<std::uint8_t>(io_interest::write) : 0U));
+      woken += wake(tasks, event.data.u64, ready);
+
+      // the one-shot event disarmed the fd, re-arm whatever is still wanted
+      const auto index = static_cast<std::uint32_t>((event.data.u64 >> 2U) & 0x3fffffffU);
+      if (index < slots.size() && slots[index].generation == static_cast<std::uint32_t>(event.data.u64 >> 32U)) {
+        slots[index].armed = 0;
+        if (slots[index].wanted != 0) { arm(index, slots[index]); }
+      }
+    }
+    return woken;
+  }
+
+  template<typename Scheduler> std::size_t poll_uring(Scheduler &tasks, const int timeout_ms)
+  {
+    __kernel_timespec timeout{};
+    unsigned min_complete = 0;
+    if (timeout_ms != 0 && !ring.has_completions()) {
+      min_complete = 1;
+      if (timeout_ms > 0) {
+        // completes with -ETIME after the timeout, or as soon as one other completion arrives
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_nsec = static_cast<long long>(timeout_ms % 1000) * 1000000;
+        auto &sqe = ring.next_sqe();
+        sqe.opcode = IORING_OP_TIMEOUT;
+        sqe.fd = -1;
+        sqe.addr = reinterpret_cast<std::uint64_t>(&timeout);// NOLINT reinterpret_cast
+        sqe.len = 1;
+        sqe.off = 1;
+        sqe.user_data = timeout_user_data;
+      }
+    }
+    ring.enter(min_complete, min_complete != 0 ? IORING_ENTER_GETEVENTS : 0U);
+
+    std::size_t woken = 0;
+    ring.drain([&](const io_uring_cqe &cqe) {
+      if (cqe.user_data == timeout_user_data) { return; }
+      const auto interest = static_cast<std::uint8_t>(cqe.user_data & 3U);
+      const auto index = static_cast<std::uint32_t>((cqe.user_data >> 2U) & 0x3fffffffU);
+      if (index < slots.size() && slots[index].generation == static_cast<std::uint32_t>(cqe.user_data >> 32U)) {
+        slots[index].armed &= static_cast<std::uint8_t>(~interest);
+      }
+      // errors and hangups are readiness too, the task's read or write will report them
+      woken += wake(tasks, cqe.user_data, interest);
+    });
+    return woken;
+  }
+
+  detail::io_uring_ring ring;
+  io_backend active = io_backend::epoll;
+  int epoll_fd = -1;
+  simple_stack_vector<watch_slot, MaxWatches> slots;
+  std::uint32_t free_head = npos;
+  std::size_t suspended = 0;
+};
+
+}// namespace lefticus::tools::lambda_coroutines
+
+#endif// LEFTICUS_TOOLS_LAMBDA_IO_HPP
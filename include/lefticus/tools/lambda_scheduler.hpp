@@ -0,0 +1,252 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_LAMBDA_SCHEDULER_HPP
+#define LEFTICUS_TOOLS_LAMBDA_SCHEDULER_HPP
+
+#include "lambda_coroutines.hpp"
+#include "simple_stack_vector.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace lefticus::tools::lambda_coroutines {
+
+// A list of tasks that are suspended until it is notified. The tasks are
+// linked through the scheduler's own slots, so waiting never allocates.
+// A wait_queue must only be used with one scheduler.
+struct wait_queue
+{
+  static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+  std::uint32_t head = npos;
+  std::uint32_t tail = npos;
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return head == npos; }
+};
+
+// What a scheduled lambda coroutine hands back to its scheduler each time it
+// suspends, with lambda_co_yield(task_step::yield()) and friends
+struct task_step
+{
+  enum struct kind : std::uint8_t { yield, wait, done };
+
+  kind action = kind::yield;
+  wait_queue *queue = nullptr;
+
+  // go to the back of the ready queue
+  [[nodiscard]] static constexpr task_step yield() noexcept { return {}; }
+  // sleep until `queue` is notified
+  [[nodiscard]] static constexpr task_step wait(wait_queue &queue) noexcept { return { kind::wait, &queue }; }
+  // finished, the task is destroyed and its slot reused
+  [[nodiscard]] static constexpr task_step done() noexcept { return { kind::done, nullptr }; }
+};
+
+struct task_id
+{
+  std::uint32_t index{};
+  std::uint32_t generation{};
+
+  [[nodiscard]] constexpr bool operator==(const task_id &) const noexcept = default;
+};
+
+// Runs up to Capacity lambda coroutines of type Task on the calling thread.
+// Ready tasks run round-robin, always taking the lowest numbered priority
+// level that has work. Task is called either with no arguments or with the
+// scheduler, so it can spawn and notify, and must return a task_step.
+//
+// Every task has the same type; capture a state enum or use a std::variant
+// of lambdas when they need to differ.
+template<typename Task, std::size_t Capacity, std::size_t PriorityLevels = 1> class scheduler
+{
+  static_assert(Capacity < wait_queue::npos, "task indexes must fit in 32 bits");
+  static_assert(PriorityLevels > 0);
+  static_assert(PriorityLevels <= 256, "a task's priority level is stored in 8 bits");
+
+  static constexpr std::uint32_t npos = wait_queue::npos;
+
+  // simple_stack_vector assigns into its slots, which lambdas with captures do not allow
+  struct slot
+  {
+    detail::movable_box<Task> holder;
+    // the next task in whichever ready, wait or free list this slot is on
+    std::uint32_t next = npos;
+    // odd while the slot holds a live task
+    std::uint32_t generation = 0;
+    std::uint8_t priority = 0;
+  };
+
+public:
+  static constexpr std::size_t priority_levels = PriorityLevels;
+
+  [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Capacity; }
+  // tasks that have been spawned and are not yet done
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return live; }
+  [[nodiscard]] constexpr bool empty() const noexcept { return live == 0; }
+  [[nodiscard]] constexpr bool has_ready() const noexcept
+  {
+    for (const auto &queue : ready) {
+      if (!queue.empty()) { return true; }
+    }
+    return false;
+  }
+
+  // queues `task` at the back of `priority`, 0 being the most urgent
+  constexpr task_id spawn(Task task, const std::size_t priority = 0)
+  {
+    if (priority >= PriorityLevels) { throw std::out_of_range("priority level out of range"); }
+
+    std::uint32_t index = free_head;
+    if (index == npos) {
+      if (slots.size() == Capacity) { throw std::length_error("scheduler is full"); }
+      index = static_cast<std::uint32_t>(slots.size());
+      slots.emplace_back();
+    } else {
+      free_head = slots[index].next;
+    }
+
+    auto &current = slots[index];
+    current.holder.value.emplace(std::move(task));
+    current.priority = static_cast<std::uint8_t>(priority);
+    ++current.generation;
+    ++live;
+    push(ready[priority], index);
+    return task_id{ index, current.generation };
+  }
+
+  // false once the task has returned task_step::done()
+  [[nodiscard]] constexpr bool running(const task_id id) const noexcept
+  {
+    return id.index < slots.size() && slots[id.index].generation == id.generation && (id.generation & 1U) == 1U;
+  }
+
+  // resumes the next ready task, returning false if nothing was ready
+  constexpr bool run_one()
+  {
+    for (auto &queue : ready) {
+      if (!queue.empty()) {
+        resume(pop(queue));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // runs until no task is ready or `max_steps` tasks have been resumed,
+  // returning the number resumed
+  constexpr std::size_t run(const std::size_t max_steps = std::numeric_limits<std::size_t>::max())
+  {
+    std::size_t steps = 0;
+    while (steps < max_steps && run_one()) { ++steps; }
+    return steps;
+  }
+
+  // makes the longest waiting task on `queue` ready, returning whether there was one
+  constexpr bool notify_one(wait_queue &queue) noexcept
+  {
+    if (queue.empty()) { return false; }
+    const auto index = pop(queue);
+    push(ready[slots[index].priority], index);
+    return true;
+  }
+
+  // makes every task waiting on `queue` ready, in the order they started waiting
+  constexpr std::size_t notify_all(wait_queue &queue) noexcept
+  {
+    std::size_t woken = 0;
+    while (notify_one(queue)) { ++woken; }
+    return woken;
+  }
+
+private:
+  constexpr void push(wait_queue &queue, const std::uint32_t index) noexcept
+  {
+    slots[index].next = npos;
+    if (queue.empty()) {
+      queue.head = index;
+    } else {
+      slots[queue.tail].next = index;
+    }
+    queue.tail = index;
+  }
+
+  [[nodiscard]] constexpr std::uint32_t pop(wait_queue &queue) noexcept
+  {
+    const auto index = queue.head;
+    queue.head = slots[index].next;
+    if (queue.head == npos) { queue.tail = npos; }
+    return index;
+  }
+
+  constexpr void resume(const std::uint32_t index)
+  {
+    // slots never move, so this stays valid if the task spawns more tasks
+    auto &current = slots[index];
+
+    const task_step step = [&] {
+      if constexpr (std::is_invocable_v<Task &, scheduler &>) {
+        return (*current.holder.value)(*this);
+      } else {
+        return (*current.holder.value)();
+      }
+    }();
+
+    switch (step.action) {
+    case task_step::kind::yield:
+      push(ready[current.priority], index);
+      break;
+    case task_step::kind::wait:
+      push(*step.queue, index);
+      break;
+    case task_step::kind::done:
+      current.holder.value.reset();
+      ++current.generation;
+      current.next = free_head;
+      free_head = index;
+      --live;
+      break;
+    }
+  }
+
+  simple_stack_vector<slot, Capacity> slots;
+  std::array<wait_queue, PriorityLevels> ready{};
+  std::uint32_t free_head = npos;
+  std::size_t live = 0;
+};
+
+}// namespace lefticus::tools::lambda_coroutines
+
+#endif// LEFTICUS_TOOLS_LAMBDA_SCHEDULER_HPP
@@ -0,0 +1,323 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_MAPPED_FLAT_MAP_HPP
+#define LEFTICUS_TOOLS_MAPPED_FLAT_MAP_HPP
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "eytzinger.hpp"
+#include "flat_map_adapter.hpp"
+#include "utility.hpp"
+
+namespace lefticus::tools {
+
+// How the records of a mapped_flat_map file are ordered
+enum struct mapped_layout : std::uint32_t { sorted = 0, eytzinger = 1 };
+
+// Access pattern hints forwarded to `madvise`
+enum struct mapped_access { normal, random, sequential, will_need, dont_need };
+
+// On-disk header. Records start at `records_offset` so they are cache line aligned.
+struct mapped_flat_map_header
+{
+  static constexpr std::uint64_t file_magic = 0x50414d54414c4654ULL;// "TFLATMAP"
+  static constexpr std::uint32_t file_version = 1;
+  static constexpr std::size_t records_offset = 64;
+
+  std::uint64_t magic = file_magic;
+  std::uint32_t version = file_version;
+  mapped_layout layout = mapped_layout::sorted;
+  std::uint64_t record_size = 0;
+  std::uint64_t count = 0;
+};
+
+static_assert(sizeof(mapped_flat_map_header) <= mapped_flat_map_header::records_offset);
+
+// RAII owner of a read-only, private mapping of an entire file
+class mapped_file
+{
+public:
+  constexpr mapped_file() = default;
+
+  explicit mapped_file(const std::filesystem::path &path)
+  {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);// NOLINT (vararg)
+    if (fd == -1) { throw std::system_error(errno, std::generic_category(), "unable to open mapped file"); }
+
+    struct ::stat status = {};
+    if (::fstat(fd, &status) == -1) {
+      const auto error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "unable to stat mapped file");
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+
+    if (size_ != 0) {
+      void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {// NOLINT (C-style cast in macro)
+        const auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "unable to map file");
+      }
+      data_ = static_cast<const std::byte *>(mapping);
+    }
+
+    // the mapping keeps the file alive, we no longer need the descriptor
+    ::close(fd);
+  }
+
+  mapped_file(const mapped_file &) = delete;
+  mapped_file &operator=(const mapped_file &) = delete;
+
+  mapped_file(mapped_file &&other) noexcept
+    : data_{ std::exchange(other.data_, nullptr) }, size_{ std::exchange(other.size_, 0) }
+  {}
+
+  mapped_file &operator=(mapped_file &&other) noexcept
+  {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~mapped_file() { unmap(); }
+
+  [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return { data_, size_ }; }
+
+  void advise(const mapped_access access) const
+  {
+    if (data_ == nullptr) { return; }
+
+    // NOLINTNEXTLINE (const_cast required by the madvise API)
+    if (::madvise(const_cast<std::byte *>(data_), size_, to_native(access)) == -1) {
+      throw std::system_error(errno, std::generic_category(), "madvise failed");
+    }
+  }
+
+private:
+  [[nodiscard]] static constexpr int to_native(const mapped_access access) noexcept
+  {
+    switch (access) {
+    case mapped_access::random:
+      return MADV_RANDOM;
+    case mapped_access::sequential:
+      return MADV_SEQUENTIAL;
+    case mapped_access::will_need:
+      return MADV_WILLNEED;
+    case mapped_access::dont_need:
+      return MADV_DONTNEED;
+    case mapped_access::normal:
+      break;
+    }
+    return MADV_NORMAL;
+  }
+
+  void unmap() noexcept
+  {
+    // NOLINTNEXTLINE (const_cast required by the munmap API)
+    if (data_ != nullptr) { ::munmap(const_cast<std::byte *>(data_), size_); }
+  }
+
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+
+// Read-only map over a file of fixed size records produced by
+// `write_mapped_flat_map`. Nothing is loaded up front, pages are faulted
+// in by the kernel as lookups touch them.
+//
+// changes from flat_map_adapter
+//  * it is immutable
+//  * lookups are O(log n) instead of a linear scan
+//  * Key and Value must be trivially copyable, and records are
+//    only meaningful on the platform that wrote them
+//  * iteration order is the storage order, which is not sorted
+//    for mapped_layout::eytzinger
+template<typename Key, typename Value> class mapped_flat_map
+{
+public:
+  using mapped_type = Value;
+  using key_type = Key;
+  using value_type = pair<Key, Value>;
+  using container_type = std::span<const value_type>;
+  using size_type = typename container_type::size_type;
+  using difference_type = typename container_type::difference_type;
+  using const_reference = const value_type &;
+  using const_iterator = typename container_type::iterator;
+  using iterator = const_iterator;
+
+  static_assert(std::is_trivially_copyable_v<Key>, "records are used in place, Key must be trivially copyable");
+  static_assert(std::is_trivially_copyable_v<Value>, "records are used in place, Value must be trivially copyable");
+
+  explicit mapped_flat_map(const std::filesystem::path &path, const mapped_access access = mapped_access::normal)
+    : file{ path }
+  {
+    const auto bytes = file.bytes();
+    if (bytes.size() < mapped_flat_map_header::records_offset) {
+      throw std::runtime_error("mapped_flat_map file is too small");
+    }
+
+    mapped_flat_map_header header;
+    std::copy_n(bytes.begin(), sizeof(header), reinterpret_cast<std::byte *>(&header));// NOLINT (type punning)
+
+    if (header.magic != mapped_flat_map_header::file_magic
+        || header.version != mapped_flat_map_header::file_version) {
+      throw std::runtime_error("not a mapped_flat_map file");
+    }
+
+    if (header.record_size != sizeof(value_type)) {
+      throw std::runtime_error("mapped_flat_map record size does not match Key / Value");
+    }
+
+    if (header.layout != mapped_layout::sorted && header.layout != mapped_layout::eytzinger) {
+      throw std::runtime_error("unknown mapped_flat_map layout");
+    }
+
+    const auto records = bytes.subspan(mapped_flat_map_header::records_offset);
+    if (records.size() / sizeof(value_type) < header.count) {
+      throw std::runtime_error("mapped_flat_map file is truncated");
+    }
+
+    layout_ = header.layout;
+    // NOLINTNEXTLINE (the writer laid out exactly these objects at this offset)
+    data = container_type{ reinterpret_cast<const value_type *>(records.data()), header.count };
+
+    advise(access);
+  }
+
+  void advise(const mapped_access access) const { file.advise(access); }
+
+  [[nodiscard]] constexpr mapped_layout layout() const noexcept { return layout_; }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return data.empty(); }
+  [[nodiscard]] constexpr size_type size() const noexcept { return data.size(); }
+
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return data.begin(); }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return data.begin(); }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return data.end(); }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return data.end(); }
+
+  template<typename K> [[nodiscard]] constexpr const_iterator find(const K &key) const
+  {
+    const auto found = lower_bound(key);
+    if (found != data.end() && found->first == key) { return found; }
+    return data.end();
+  }
+
+  template<typename K> [[nodiscard]] constexpr bool contains(const K &key) const { return find(key) != data.end(); }
+
+  template<typename K> [[nodiscard]] constexpr const mapped_type &at(const K &key) const
+  {
+    const auto itr = find(key);
+    if (itr != data.end()) { return itr->second; }
+    throw std::out_of_range("Key not found");
+  }
+
+  container_type data;
+
+private:
+  template<typename K> [[nodiscard]] constexpr const_iterator lower_bound(const K &key) const
+  {
+    if (layout_ == mapped_layout::eytzinger) {
+      return std::next(data.begin(),
+        static_cast<difference_type>(eytzinger_lower_bound(data, key, &value_type::first)));
+    }
+
+    return std::lower_bound(
+      data.begin(), data.end(), key, [](const value_type &lhs, const K &rhs) { return lhs.first < rhs; });
+  }
+
+  mapped_file file;
+  mapped_layout layout_ = mapped_layout::sorted;
+};
+
+
+// Writes any flat_map_adapter as a file that `mapped_flat_map` can open.
+// Keys are sorted on the way out, the source map is left untouched.
+template<typename Key, typename Value, typename Container>
+void write_mapped_flat_map(const std::filesystem::path &path,
+  const flat_map_adapter<Key, Value, Container> &map,
+  const mapped_layout layout = mapped_layout::sorted)
+{
+  using record = pair<Key, Value>;
+  static_assert(std::is_trivially_copyable_v<record>, "Key and Value must be trivially copyable");
+
+  std::vector<record> records;
+  records.reserve(map.size());
+  for (const auto &[key, value] : map) { records.push_back(record{ key, value }); }
+
+  std::sort(records.begin(), records.end(), [](const record &lhs, const record &rhs) { return lhs.first < rhs.first; });
+
+  if (layout == mapped_layout::eytzinger) {
+    std::vector<record> ordered(records.size());
+    to_eytzinger(records.begin(), records.end(), ordered.begin());
+    records = std::move(ordered);
+  }
+
+  mapped_flat_map_header header;
+  header.layout = layout;
+  header.record_size = sizeof(record);
+  header.count = records.size();
+
+  std::array<char, mapped_flat_map_header::records_offset> header_block{};
+  std::copy_n(reinterpret_cast<const char *>(&header), sizeof(header), header_block.begin());// NOLINT (type punning)
+
+  std::ofstream output(path, std::ios::binary | std::ios::trunc);
+  output.write(header_block.data(), static_cast<std::streamsize>(header_block.size()));
+  output.write(reinterpret_cast<const char *>(records.data()),// NOLINT (type punning)
+    static_cast<std::streamsize>(records.size() * sizeof(record)));
+
+  if (!output) { throw std::runtime_error("unable to write mapped_flat_map file"); }
+}
+
+}// namespace lefticus::tools
+
+#endif// LEFTICUS_TOOLS_MAPPED_FLAT_MAP_HPP
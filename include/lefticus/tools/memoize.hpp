@@ -0,0 +1,143 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+
+#ifndef LEFTICUS_TOOLS_MEMOIZE_HPP
+#define LEFTICUS_TOOLS_MEMOIZE_HPP
+
+#include "simple_stack_flat_map.hpp"
+#include "type_lists.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace lefticus::tools {
+
+// Remembers the results of the last Capacity distinct calls to a pure
+// Function, evicting the least recently used. It is for pure functions that
+// cannot be evaluated at compile time; use constant_cache for those that can.
+//
+// Lookups are a linear scan, so keep Capacity small. Arguments are compared
+// with ==, and both they and the result must be default constructible.
+template<typename Function, std::size_t Capacity, typename... Args> class memoized
+{
+  static_assert(Capacity > 0);
+
+  using key_type = std::tuple<std::remove_cvref_t<Args>...>;
+
+public:
+  using result_type = std::remove_cvref_t<std::invoke_result_t<Function &, const std::remove_cvref_t<Args> &...>>;
+
+  constexpr explicit memoized(Function function_) : function(std::move(function_)) {}
+
+  constexpr result_type operator()(const std::remove_cvref_t<Args> &...args)
+  {
+    ++clock;
+    const key_type key{ args... };
+    if (const auto found = cache.find(key); found != cache.end()) {
+      found->second.last_used = clock;
+      return found->second.value;
+    }
+
+    auto value = std::invoke(function, args...);
+    if (cache.size() < Capacity) {
+      cache.try_emplace(key, value, clock);
+    } else {
+      auto oldest = cache.begin();
+      for (auto itr = cache.begin(); itr != cache.end(); ++itr) {
+        if (itr->second.last_used < oldest->second.last_used) { oldest = itr; }
+      }
+      oldest->first = key;
+      oldest->second = entry{ value, clock };
+    }
+    return value;
+  }
+
+  [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Capacity; }
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return cache.size(); }
+  [[nodiscard]] constexpr bool contains(const std::remove_cvref_t<Args> &...args) const
+  {
+    return cache.find(key_type{ args... }) != cache.end();
+  }
+
+  constexpr void clear() { cache.clear(); }
+
+private:
+  struct entry
+  {
+    result_type value{};
+    std::uint64_t last_used = 0;
+  };
+
+  Function function;
+  simple_stack_flat_map<key_type, entry, Capacity> cache;
+  std::uint64_t clock = 0;
+};
+
+namespace detail {
+  template<typename Result, typename... Args> auto memoize_arguments(Result (*)(Args...)) -> type_list<Args...>;
+  template<typename Result, typename... Args>
+  auto memoize_arguments(Result (*)(Args...) noexcept) -> type_list<Args...>;
+  template<typename Result, typename Class, typename... Args>
+  auto memoize_arguments(Result (Class::*)(Args...)) -> type_list<Args...>;
+  template<typename Result, typename Class, typename... Args>
+  auto memoize_arguments(Result (Class::*)(Args...) const) -> type_list<Args...>;
+  template<typename Result, typename Class, typename... Args>
+  auto memoize_arguments(Result (Class::*)(Args...) noexcept) -> type_list<Args...>;
+  template<typename Result, typename Class, typename... Args>
+  auto memoize_arguments(Result (Class::*)(Args...) const noexcept) -> type_list<Args...>;
+
+  template<typename Function> struct memoize_signature
+  {
+    using type = decltype(memoize_arguments(&Function::operator()));
+  };
+  template<typename Function>
+    requires std::is_pointer_v<Function>
+  struct memoize_signature<Function>
+  {
+    using type = decltype(memoize_arguments(Function{}));
+  };
+}// namespace detail
+
+// memoized, taking the argument types from a function pointer or a lambda
+// that is not generic
+template<std::size_t Capacity, typename Function> [[nodiscard]] constexpr auto memoize(Function function)
+{
+  return []<typename... Args>(Function &&func, type_list<Args...>) {
+    return memoized<Function, Capacity, Args...>{ std::move(func) };
+  }(std::move(function), typename detail::memoize_signature<std::decay_t<Function>>::type{});
+}
+
+}// namespace lefticus::tools
+
+#endif// LEFTICUS_TOOLS_MEMOIZE_HPP
@@ -0,0 +1,284 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_NON_PROMOTING_ENDIAN_HPP
+#define LEFTICUS_TOOLS_NON_PROMOTING_ENDIAN_HPP
+
+#include "non_promoting_ints.hpp"
+
+#include <array>
+#include <bit>
+#include <climits>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace lefticus::tools {
+
+// An int_np stored as bytes in a fixed byte order with alignment 1, for
+// overlaying structs on wire buffers with std::bit_cast. Values are converted
+// on every access; the byte loops below compile to a plain load or store plus
+// a byte swap when the order differs from the native one.
+//
+// Arithmetic loads both sides and returns the native int_np, so expressions
+// keep int_np's non-promoting semantics and overflow policy. An endian_np
+// converts implicitly to its int_np, but has to be assigned from one
+// explicitly, which keeps mixed expressions unambiguous.
+template<std::endian Order, std::integral Type, typename Overflow = overflow::wrap> struct endian_np
+{
+  static_assert(Order == std::endian::big || Order == std::endian::little);
+
+  using value_type = Type;
+  using native_type = int_np<Type, Overflow>;
+  static constexpr std::endian byte_order = Order;
+
+private:
+  using bits_type = std::make_unsigned_t<value_type>;
+
+  std::array<unsigned char, sizeof(value_type)> storage;
+
+  // position in storage of the index'th most significant byte
+  [[nodiscard]] static constexpr std::size_t position(const std::size_t index) noexcept
+  {
+    return Order == std::endian::big ? index : sizeof(value_type) - 1 - index;
+  }
+
+public:
+  // trivial, so a struct of these can be std::bit_cast from raw bytes
+  constexpr endian_np() noexcept = default;
+
+  constexpr explicit endian_np(const native_type value) noexcept { store(value); }
+
+  [[nodiscard]] static constexpr endian_np from(const std::integral auto value) noexcept(
+    noexcept(native_type::from(value)))
+  {
+    return endian_np{ native_type::from(value) };
+  }
+
+  [[nodiscard]] constexpr native_type load() const noexcept
+  {
+    bits_type bits{};
+    for (std::size_t index = 0; index < sizeof(value_type); ++index) {
+      const auto byte = detail::integral_cast<bits_type>(storage[position(index)]);
+      const auto shift = (sizeof(value_type) - 1 - index) * CHAR_BIT;
+      bits = detail::integral_cast<bits_type>(bits | detail::integral_cast<bits_type>(byte << shift));
+    }
+    return native_type{ detail::integral_cast<value_type>(bits) };
+  }
+
+  constexpr void store(const native_type value) noexcept
+  {
+    auto bits = value.bits();
+    for (std::size_t index = sizeof(value_type); index-- > 0;) {
+      storage[position(index)] = static_cast<unsigned char>(bits & 0xFFU);
+      bits = detail::integral_cast<bits_type>(bits >> CHAR_BIT);
+    }
+  }
+
+  [[nodiscard]] constexpr value_type get() const noexcept { return load().get(); }
+
+  // NOLINTNEXTLINE hicpp-explicit-conversions
+  constexpr operator native_type() const noexcept { return load(); }
+
+  constexpr endian_np &operator=(const native_type value) &noexcept
+  {
+    store(value);
+    return *this;
+  }
+
+  [[nodiscard]] constexpr const std::array<unsigned char, sizeof(value_type)> &bytes() const noexcept
+  {
+    return storage;
+  }
+
+  // endian_np op endian_np; mixed endian_np op int_np uses int_np's operators
+  [[nodiscard]] friend constexpr native_type operator+(const endian_np &lhs, const endian_np &rhs) noexcept(
+    noexcept(lhs.load() + rhs.load()))
+  {
+    return lhs.load() + rhs.load();
+  }
+  [[nodiscard]] friend constexpr native_type operator-(const endian_np &lhs, const endian_np &rhs) noexcept(
+    noexcept(lhs.load() - rhs.load()))
+  {
+    return lhs.load() - rhs.load();
+  }
+  [[nodiscard]] friend constexpr native_type operator*(const endian_np &lhs, const endian_np &rhs) noexcept(
+    noexcept(lhs.load() * rhs.load()))
+  {
+    return lhs.load() * rhs.load();
+  }
+  [[nodiscard]] friend constexpr native_type operator/(const endian_np &lhs, const endian_np &rhs) noexcept(
+    noexcept(lhs.load() / rhs.load()))
+  {
+    return lhs.load() / rhs.load();
+  }
+  [[nodiscard]] friend constexpr native_type operator%(const endian_np &lhs, const endian_np &rhs) noexcept(
+    noexcept(lhs.load() % rhs.load()))
+  {
+    return lhs.load() % rhs.load();
+  }
+  [[nodiscard]] friend constexpr native_type operator&(const endian_np &lhs, const endian_np &rhs) noexcept
+  {
+    return lhs.load() & rhs.load();
+  }
+  [[nodiscard]] friend constexpr native_type operator|(const endian_np &lhs, const endian_np &rhs) noexcept
+  {
+    return lhs.load() | rhs.load();
+  }
+  [[nodiscard]] friend constexpr native_type operator^(const endian_np &lhs, const endian_np &rhs) noexcept
+  {
+    return lhs.load() ^ rhs.load();
+  }
+  [[nodiscard]] friend constexpr native_type operator<<(const endian_np &lhs, const std::integral auto rhs) noexcept
+  {
+    return lhs.load() << rhs;
+  }
+  [[nodiscard]] friend constexpr native_type operator>>(const endian_np &lhs, const std::integral auto rhs) noexcept
+  {
+    return lhs.load() >> rhs;
+  }
+
+  [[nodiscard]] constexpr native_type operator~() const noexcept { return ~load(); }
+
+  // compound assignment accepts anything the int_np operator accepts
+  constexpr endian_np &operator+=(const auto &rhs) &noexcept(noexcept(std::declval<native_type &>() += rhs))
+  {
+    auto value = load();
+    value += rhs;
+    store(value);
+    return *this;
+  }
+  constexpr endian_np &operator-=(const auto &rhs) &noexcept(noexcept(std::declval<native_type &>() -= rhs))
+  {
+    auto value = load();
+    value -= rhs;
+    store(value);
+    return *this;
+  }
+  constexpr endian_np &operator*=(const auto &rhs) &noexcept(noexcept(std::declval<native_type &>() *= rhs))
+  {
+    auto value = load();
+    value *= rhs;
+    store(value);
+    return *this;
+  }
+  constexpr endian_np &operator/=(const auto &rhs) &noexcept(noexcept(std::declval<native_type &>() /= rhs))
+  {
+    auto value = load();
+    value /= rhs;
+    store(value);
+    return *this;
+  }
+  constexpr endian_np &operator%=(const auto &rhs) &noexcept(noexcept(std::declval<native_type &>() %= rhs))
+  {
+    auto value = load();
+    value %= rhs;
+    store(value);
+    return *this;
+  }
+  constexpr endian_np &operator&=(const native_type rhs) &noexcept
+  {
+    store(load() & rhs);
+    return *this;
+  }
+  constexpr endian_np &operator|=(const native_type rhs) &noexcept
+  {
+    store(load() | rhs);
+    return *this;
+  }
+  constexpr endian_np &operator^=(const native_type rhs) &noexcept
+  {
+    store(load() ^ rhs);
+    return *this;
+  }
+  constexpr endian_np &operator<<=(const std::integral auto rhs) &noexcept
+  {
+    store(load() << rhs);
+    return *this;
+  }
+  constexpr endian_np &operator>>=(const std::integral auto rhs) &noexcept
+  {
+    store(load() >> rhs);
+    return *this;
+  }
+
+  constexpr endian_np &operator++() &noexcept(noexcept(++std::declval<native_type &>()))
+  {
+    auto value = load();
+    ++value;
+    store(value);
+    return *this;
+  }
+
+  constexpr endian_np &operator--() &noexcept(noexcept(--std::declval<native_type &>()))
+  {
+    auto value = load();
+    --value;
+    store(value);
+    return *this;
+  }
+
+  // you shouldn't use post-increment unless you plan to use the
+  // result. So I made it [[nodiscard]] - Jason
+  [[nodiscard]] constexpr native_type operator++(int) &noexcept(noexcept(++std::declval<native_type &>()))
+  {
+    const auto old = load();
+    ++*this;
+    return old;
+  }
+
+  [[nodiscard]] constexpr native_type operator--(int) &noexcept(noexcept(--std::declval<native_type &>()))
+  {
+    const auto old = load();
+    --*this;
+    return old;
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const endian_np &lhs, const endian_np &rhs) noexcept
+  {
+    return lhs.load() == rhs.load();
+  }
+
+  [[nodiscard]] friend constexpr auto operator<=>(const endian_np &lhs, const endian_np &rhs) noexcept
+  {
+    return lhs.load() <=> rhs.load();
+  }
+};
+
+template<std::integral Type, typename Overflow = overflow::wrap>
+using big_np = endian_np<std::endian::big, Type, Overflow>;
+
+template<std::integral Type, typename Overflow = overflow::wrap>
+using little_np = endian_np<std::endian::little, Type, Overflow>;
+
+static_assert(sizeof(big_np<std::uint32_t>) == 4 && alignof(big_np<std::uint32_t>) == 1);
+static_assert(std::is_trivially_copyable_v<little_np<std::int64_t>> && std::is_trivial_v<big_np<std::uint16_t>>);
+}// namespace lefticus::tools
+
+#endif
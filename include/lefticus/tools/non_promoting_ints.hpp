@@ -29,19 +29,376 @@ For more information, please refer to <https://unlicense.org>
 #ifndef LEFTICUS_TOOLS_NON_PROMOTING_INTS_HPP
 #define LEFTICUS_TOOLS_NON_PROMOTING_INTS_HPP
 
+#include <bit>
+#include <climits>
 #include <compare>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 namespace lefticus::tools {
-template<std::integral Type> struct int_np
+namespace detail {
+  // static_cast, without tripping -Wuseless-cast when the types already match
+  template<std::integral To> [[nodiscard]] constexpr To integral_cast(const std::integral auto value) noexcept
+  {
+    if constexpr (std::is_same_v<To, std::remove_cvref_t<decltype(value)>>) {
+      return value;
+    } else {
+      return static_cast<To>(value);
+    }
+  }
+
+  [[nodiscard]] constexpr bool is_negative(const std::integral auto value) noexcept
+  {
+    if constexpr (std::is_signed_v<decltype(value)>) {
+      return value < 0;
+    } else {
+      return false;
+    }
+  }
+
+  template<std::integral Type> [[nodiscard]] constexpr Type limit(const bool upper) noexcept
+  {
+    return upper ? std::numeric_limits<Type>::max() : std::numeric_limits<Type>::min();
+  }
+
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128_builtin;// NOLINT modernize-use-using
+#endif
+
+  struct wide_product
+  {
+    std::uint64_t low;
+    std::uint64_t high;
+  };
+
+  // (high:low) / divisor, requires high < divisor so the quotient fits
+  [[nodiscard]] constexpr std::uint64_t divide_wide(std::uint64_t high,
+    std::uint64_t low,
+    const std::uint64_t divisor) noexcept
+  {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<std::uint64_t>(((static_cast<uint128_builtin>(high) << 64U) | low) / divisor);
+#else
+    for (int bit = 0; bit < 64; ++bit) {// NOLINT Magic Number
+      const bool carry = (high >> 63U) != 0;
+      high = (high << 1U) | (low >> 63U);
+      low <<= 1U;
+      if (carry || high >= divisor) {
+        high -= divisor;
+        low |= 1U;
+      }
+    }
+    return low;
+#endif
+  }
+
+  // full 64 x 64 -> 128 bit product
+  [[nodiscard]] constexpr wide_product multiply_wide(const std::uint64_t lhs, const std::uint64_t rhs) noexcept
+  {
+#if defined(__SIZEOF_INT128__)
+    const auto product = static_cast<uint128_builtin>(lhs) * rhs;
+    return { static_cast<std::uint64_t>(product), static_cast<std::uint64_t>(product >> 64U) };
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+    if (!std::is_constant_evaluated()) {
+      std::uint64_t high = 0;
+      const std::uint64_t low = _umul128(lhs, rhs, &high);
+      return { low, high };
+    }
+#endif
+    constexpr std::uint64_t half_mask = 0xFFFFFFFFU;
+    const std::uint64_t lhs_low = lhs & half_mask;
+    const std::uint64_t lhs_high = lhs >> 32U;
+    const std::uint64_t rhs_low = rhs & half_mask;
+    const std::uint64_t rhs_high = rhs >> 32U;
+
+    const std::uint64_t low_low = lhs_low * rhs_low;
+    const std::uint64_t high_low = lhs_high * rhs_low;
+    const std::uint64_t low_high = lhs_low * rhs_high;
+    const std::uint64_t high_high = lhs_high * rhs_high;
+
+    const std::uint64_t middle = (low_low >> 32U) + (high_low & half_mask) + low_high;
+    return { (middle << 32U) | (low_low & half_mask), high_high + (high_low >> 32U) + (middle >> 32U) };
+#endif
+  }
+  enum struct arithmetic_op { add, sub, mul };
+
+  // two's complement result plus overflow flag, for compilers without __builtin_*_overflow
+  template<arithmetic_op Op, std::integral Type>
+  [[nodiscard]] constexpr bool portable_overflow(const Type lhs, const Type rhs, Type &result) noexcept
+  {
+    using unsigned_type = std::common_type_t<std::make_unsigned_t<Type>, unsigned int>;
+    constexpr auto max = std::numeric_limits<Type>::max();
+    constexpr auto min = std::numeric_limits<Type>::min();
+
+    const auto ulhs = integral_cast<unsigned_type>(lhs);
+    const auto urhs = integral_cast<unsigned_type>(rhs);
+
+    if constexpr (Op == arithmetic_op::add) {
+      result = integral_cast<Type>(integral_cast<unsigned_type>(ulhs + urhs));
+      if constexpr (std::is_signed_v<Type>) {
+        return (rhs > 0 && lhs > max - rhs) || (rhs < 0 && lhs < min - rhs);
+      } else {
+        return lhs > max - rhs;
+      }
+    } else if constexpr (Op == arithmetic_op::sub) {
+      result = integral_cast<Type>(integral_cast<unsigned_type>(ulhs - urhs));
+      if constexpr (std::is_signed_v<Type>) {
+        return (rhs < 0 && lhs > max + rhs) || (rhs > 0 && lhs < min + rhs);
+      } else {
+        return lhs < rhs;
+      }
+    } else {
+      result = integral_cast<Type>(integral_cast<unsigned_type>(ulhs * urhs));
+      if (lhs == 0 || rhs == 0) { return false; }
+      if constexpr (std::is_signed_v<Type>) {
+        if (lhs > 0) { return rhs > 0 ? lhs > max / rhs : rhs < min / lhs; }
+        return rhs > 0 ? lhs < min / rhs : rhs < max / lhs;
+      } else {
+        return lhs > max / rhs;
+      }
+    }
+  }
+
+  template<arithmetic_op Op, std::integral Type>
+  [[nodiscard]] constexpr bool portable_overflow(const std::integral auto lhs,
+    const std::integral auto rhs,
+    Type &result) noexcept
+  {
+    // operands that do not fit are reduced modulo 2^N, which still gives the
+    // correct wrapped result, but the overflow report becomes conservative
+    const bool in_range = std::in_range<Type>(lhs) && std::in_range<Type>(rhs);
+    return portable_overflow<Op>(integral_cast<Type>(lhs), integral_cast<Type>(rhs), result) || !in_range;
+  }
+
+  // these compute the infinitely precise result of `lhs op rhs`, store it
+  // wrapped into `result` and return true if it did not fit
+  template<std::integral Type>
+  constexpr bool add_overflow(const std::integral auto lhs, const std::integral auto rhs, Type &result) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_add_overflow(lhs, rhs, &result);
+#else
+    return portable_overflow<arithmetic_op::add>(lhs, rhs, result);
+#endif
+  }
+
+  template<std::integral Type>
+  constexpr bool sub_overflow(const std::integral auto lhs, const std::integral auto rhs, Type &result) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_sub_overflow(lhs, rhs, &result);
+#else
+    return portable_overflow<arithmetic_op::sub>(lhs, rhs, result);
+#endif
+  }
+
+  template<std::integral Type>
+  constexpr bool mul_overflow(const std::integral auto lhs, const std::integral auto rhs, Type &result) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_mul_overflow(lhs, rhs, &result);
+#else
+    return portable_overflow<arithmetic_op::mul>(lhs, rhs, result);
+#endif
+  }
+
+  // division happens in the promoted type, like the builtin operator, and the
+  // quotient is then narrowed by the policy. `x / -1` is the only quotient that
+  // can overflow, so it is handled as a negation.
+  template<typename Policy, std::integral Type>
+  [[nodiscard]] constexpr Type divide(const Type lhs, const std::integral auto rhs) noexcept(Policy::is_noexcept)
+  {
+    if constexpr (std::is_signed_v<decltype(lhs / rhs)>) {
+      if (rhs == -1) { return Policy::sub(Type{}, lhs); }
+    }
+    return Policy::template narrow<Type>(lhs / rhs);
+  }
+
+  template<typename Policy, std::integral Type>
+  [[nodiscard]] constexpr Type remainder(const Type lhs, const std::integral auto rhs) noexcept(Policy::is_noexcept)
+  {
+    if constexpr (std::is_signed_v<decltype(lhs % rhs)>) {
+      if (rhs == -1) { return Type{}; }
+    }
+    return Policy::template narrow<Type>(lhs % rhs);
+  }
+}// namespace detail
+
+// overflow policies for int_np. Bitwise and shift operations are always
+// modular; the policy applies to +, -, *, /, %, ++, -- and `from`
+namespace overflow {
+  // two's complement wrap-around, well defined for signed types as well
+  struct wrap
+  {
+    static constexpr bool is_noexcept = true;
+
+    template<std::integral Type> [[nodiscard]] static constexpr Type narrow(const std::integral auto value) noexcept
+    {
+      return detail::integral_cast<Type>(value);
+    }
+
+    template<std::integral Type>
+    [[nodiscard]] static constexpr Type add(const Type lhs, const std::integral auto rhs) noexcept
+    {
+      Type result{};
+      detail::add_overflow(lhs, rhs, result);
+      return result;
+    }
+
+    template<std::integral Type>
+    [[nodiscard]] static constexpr Type sub(const Type lhs, const std::integral auto rhs) noexcept
+    {
+      Type result{};
+      detail::sub_overflow(lhs, rhs, result);
+      return result;
+    }
+
+    template<std::integral Type>
+    [[nodiscard]] static constexpr Type mul(const Type lhs, const std::integral auto rhs) noexcept
+    {
+      Type result{};
+      detail::mul_overflow(lhs, rhs, result);
+      return result;
+    }
+
+    // division by zero is a precondition violation, as with the builtin operators
+    template<std::integral Type>
+    [[nodiscard]] static constexpr Type div(const Type lhs, const std::integral auto rhs) noexcept
+    {
+      return detail::divide<wrap>(lhs, rhs);
+    }
+
+    template<std::integral Type>
+    [[nodiscard]] static constexpr Type mod(const Type lhs, const std::integral auto rhs) noexcept
+    {
+      return detail::remainder<wrap>(lhs, rhs);
+    }
+  };
+
+  // clamps to numeric_limits<Type>::min() / max(). The clamp is a select on
+  // the overflow flag, so it compiles to a conditional move rather than a branch
+  struct saturate
+  {
+    static constexpr bool is_noexcept = true;
+
+    template<std::integral Type> [[nodiscard]] static constexpr Type narrow(const std::integral auto value) noexcept
+    {
+      if (std::cmp_less(value, std::numeric_limits<Type>::min())) { return std::numeric_limits<Type>::min(); }
+      if (std::cmp_greater(value, std::numeric_limits<Type>::max())) { return std::numeric_limits<Type>::max(); }
+      return detail::integral_cast<Type>(value);
+    }
+
+    template<std::integral Type>
+    [[nodiscard]] static constexpr Type add(const Type lhs, const std::integral auto rhs) noexcept
+    {
+      Type result{};
+      const bool overflowed = detail::add_overflow(lhs, rhs, result);
+      return overflowed ? detail::limit<Type>(!detail::is_negative(rhs)) : result;
+    }
+
+    template<std::integral Type>
+    [[nodiscard]] static constexpr Type sub(const Type lhs, const std::integral auto rhs) noexcept
+    {
+      Type result{};
+      const bool overflowed = detail::sub_overflow(lhs, rhs, result);
+      return overflowed ? detail::limit<Type>(detail::is_negative(rhs)) : result;
+    }
+
+    template<std::integral Type>
+    [[nodiscard]] static constexpr Type mul(const Type lhs, const std::integral auto rhs) noexcept
+    {
+      Type result{};
+      const bool overflowed = detail::mul_overflow(lhs, rhs, result);
+      return overflowed ? detail::limit<Type>(detail::is_negative(lhs) == detail::is_negative(rhs)) : result;
+    }
+
+    // division by zero is a precondition violation, as with the builtin operators
+    template<std::integral Type>
+    [[nodiscard]] static constexpr Type div(const Type lhs, const std::integral auto rhs) noexcept
+    {
+      return detail::divide<saturate>(lhs, rhs);
+    }
+
+    template<std::integral Type>
+    [[nodiscard]] static constexpr Type mod(const Type lhs, const std::integral auto rhs) noexcept
+    {
+      return detail::remainder<saturate>(lhs, rhs);
+    }
+  };
+
+  // throws std::overflow_error if the result does not fit, and
+  // std::domain_error on division by zero
+  struct checked
+  {
+    static constexpr bool is_noexcept = false;
+
+    template<std::integral Type> [[nodiscard]] static constexpr Type narrow(const std::integral auto value)
+    {
+      if (!std::in_range<Type>(value)) { throw std::overflow_error("int_np value out of range"); }
+      return detail::integral_cast<Type>(value);
+    }
+
+    template<std::integral Type> [[nodiscard]] static constexpr Type add(const Type lhs, const std::integral auto rhs)
+    {
+      Type result{};
+      if (detail::add_overflow(lhs, rhs, result)) { throw std::overflow_error("int_np addition overflow"); }
+      return result;
+    }
+
+    template<std::integral Type> [[nodiscard]] static constexpr Type sub(const Type lhs, const std::integral auto rhs)
+    {
+      Type result{};
+      if (detail::sub_overflow(lhs, rhs, result)) { throw std::overflow_error("int_np subtraction overflow"); }
+      return result;
+    }
+
+    template<std::integral Type> [[nodiscard]] static constexpr Type mul(const Type lhs, const std::integral auto rhs)
+    {
+      Type result{};
+      if (detail::mul_overflow(lhs, rhs, result)) { throw std::overflow_error("int_np multiplication overflow"); }
+      return result;
+    }
+
+    template<std::integral Type> [[nodiscard]] static constexpr Type div(const Type lhs, const std::integral auto rhs)
+    {
+      if (rhs == 0) { throw std::domain_error("int_np division by zero"); }
+      return detail::divide<checked>(lhs, rhs);
+    }
+
+    template<std::integral Type> [[nodiscard]] static constexpr Type mod(const Type lhs, const std::integral auto rhs)
+    {
+      if (rhs == 0) { throw std::domain_error("int_np division by zero"); }
+      return detail::remainder<checked>(lhs, rhs);
+    }
+  };
+}// namespace overflow
+
+template<std::integral Type, typename Overflow = overflow::wrap> struct int_np
 {
   using value_type = Type;
+  using overflow_policy = Overflow;
 
 private:
   value_type value;
 
+  static constexpr bool nothrow = Overflow::is_noexcept;
+
+  // bitwise and shift results are always reduced modulo 2^N
+  [[nodiscard]] static constexpr int_np wrapped(const std::integral auto value) noexcept
+  {
+    return int_np{ detail::integral_cast<value_type>(value) };
+  }
+
 public:
   // if it's the proper type, make it easy to convert
   // cppcheck-suppress noExplicitConstructor
@@ -54,83 +411,93 @@ public:
 
   [[nodiscard]] constexpr value_type get() const noexcept { return value; }
 
-  [[nodiscard]] static constexpr int_np from(const std::integral auto value)
+  // narrows according to the overflow policy
+  [[nodiscard]] static constexpr int_np from(const std::integral auto value) noexcept(nothrow)
   {
-    return int_np{ static_cast<value_type>(value) };
+    return int_np{ Overflow::template narrow<value_type>(value) };
   }
 
   // all of these operations are limited to exact type matches
   // so there is no question at all about what promotion should happen
   [[nodiscard]] friend constexpr int_np operator|(const int_np lhs, const int_np rhs) noexcept
   {
-    return from(lhs.value | rhs.value);
+    return wrapped(lhs.value | rhs.value);
   }
   [[nodiscard]] friend constexpr int_np operator&(const int_np lhs, const int_np rhs) noexcept
   {
-    return from(lhs.value & rhs.value);
+    return wrapped(lhs.value & rhs.value);
   }
   [[nodiscard]] friend constexpr int_np operator^(const int_np lhs, const int_np rhs) noexcept
   {
-    return from(lhs.value ^ rhs.value);
+    return wrapped(lhs.value ^ rhs.value);
   }
-  [[nodiscard]] friend constexpr int_np operator*(const int_np lhs, const int_np rhs) noexcept
+  [[nodiscard]] friend constexpr int_np operator*(const int_np lhs, const int_np rhs) noexcept(nothrow)
   {
-    return from(lhs.value * rhs.value);
+    return int_np{ Overflow::mul(lhs.value, rhs.value) };
   }
-  [[nodiscard]] friend constexpr int_np operator+(const int_np lhs, const int_np rhs) noexcept
+  [[nodiscard]] friend constexpr int_np operator+(const int_np lhs, const int_np rhs) noexcept(nothrow)
   {
-    return from(lhs.value + rhs.value);
+    return int_np{ Overflow::add(lhs.value, rhs.value) };
   }
-  [[nodiscard]] friend constexpr int_np operator-(const int_np lhs, const int_np rhs) noexcept
+  [[nodiscard]] friend constexpr int_np operator-(const int_np lhs, const int_np rhs) noexcept(nothrow)
   {
-    return from(lhs.value - rhs.value);
+    return int_np{ Overflow::sub(lhs.value, rhs.value) };
   }
-  [[nodiscard]] friend constexpr int_np operator%(const int_np lhs, const int_np rhs) noexcept
+  [[nodiscard]] friend constexpr int_np operator%(const int_np lhs, const int_np rhs) noexcept(nothrow)
   {
-    return from(lhs.value % rhs.value);
+    return int_np{ Overflow::mod(lhs.value, rhs.value) };
   }
-  [[nodiscard]] friend constexpr int_np operator/(const int_np lhs, const int_np rhs) noexcept
+  [[nodiscard]] friend constexpr int_np operator/(const int_np lhs, const int_np rhs) noexcept(nothrow)
   {
-    return from(lhs.value / rhs.value);
+    return int_np{ Overflow::div(lhs.value, rhs.value) };
   }
 
-  constexpr int_np operator~() const noexcept { return from(~value); }
+  constexpr int_np operator~() const noexcept { return wrapped(~value); }
 
-  constexpr int_np &operator++() &noexcept
+  constexpr int_np &operator++() &noexcept(nothrow)
   {
-    ++value;
+    value = Overflow::add(value, value_type{ 1 });
     return *this;
   }
 
   // you shouldn't use post-increment unless you plan to use the
   // result. So I made it [[nodiscard]] - Jason
-  [[nodiscard]] constexpr int_np operator++(int) &noexcept { return from(value++); }
+  [[nodiscard]] constexpr int_np operator++(int) &noexcept(nothrow)
+  {
+    const int_np old = *this;
+    ++*this;
+    return old;
+  }
 
-  constexpr int_np &operator--() &noexcept
+  constexpr int_np &operator--() &noexcept(nothrow)
   {
-    --value;
+    value = Overflow::sub(value, value_type{ 1 });
     return *this;
   }
 
   // you shouldn't use post-increment unless you plan to use the
   // result. So I made it [[nodiscard]] - Jason
-  [[nodiscard]] constexpr int_np operator--(int) &noexcept { return from(value--); }
-
+  [[nodiscard]] constexpr int_np operator--(int) &noexcept(nothrow)
+  {
+    const int_np old = *this;
+    --*this;
+    return old;
+  }
   // bitwise operations must be a specific match and
   // we'll get implicit conversion into the operator if it's safe
   constexpr int_np &operator&=(const int_np rhs) &noexcept
   {
-    value = static_cast<value_type>(value & rhs.value);
+    value = detail::integral_cast<value_type>(value & rhs.value);
     return *this;
   }
   constexpr int_np &operator|=(const int_np rhs) &noexcept
   {
-    value = static_cast<value_type>(value | rhs.value);
+    value = detail::integral_cast<value_type>(value | rhs.value);
     return *this;
   }
   constexpr int_np &operator^=(const int_np rhs) &noexcept
   {
-    value = static_cast<value_type>(value ^ rhs.value);
+    value = detail::integral_cast<value_type>(value ^ rhs.value);
     return *this;
   }
 
@@ -140,46 +507,52 @@ public:
   // the LHS
   [[nodiscard]] friend constexpr int_np operator<<(const int_np lhs, const std::integral auto rhs) noexcept
   {
-    return from(lhs.value << rhs);
+    return wrapped(lhs.value << rhs);
   }
   [[nodiscard]] friend constexpr int_np operator>>(const int_np lhs, const std::integral auto rhs) noexcept
   {
-    return from(lhs.value >> rhs);
+    return wrapped(lhs.value >> rhs);
   }
 
   constexpr int_np &operator<<=(const std::integral auto rhs) &noexcept
   {
-    value = static_cast<value_type>(value << rhs);
+    value = detail::integral_cast<value_type>(value << rhs);
     return *this;
   }
 
   constexpr int_np &operator>>=(const std::integral auto rhs) &noexcept
   {
-    value = static_cast<value_type>(value >> rhs);
+    value = detail::integral_cast<value_type>(value >> rhs);
+    return *this;
+  }
+
+  constexpr int_np &operator+=(const std::integral auto rhs) &noexcept(nothrow)
+  {
+    value = Overflow::add(value, rhs);
     return *this;
   }
 
-  constexpr int_np &operator+=(const std::integral auto rhs) &noexcept
+  constexpr int_np &operator-=(const std::integral auto rhs) &noexcept(nothrow)
   {
-    value = static_cast<value_type>(value + rhs);
+    value = Overflow::sub(value, rhs);
     return *this;
   }
 
-  constexpr int_np &operator-=(const std::integral auto rhs) &noexcept
+  constexpr int_np &operator*=(const std::integral auto rhs) &noexcept(nothrow)
   {
-    value = static_cast<value_type>(value - rhs);
+    value = Overflow::mul(value, rhs);
     return *this;
   }
 
-  constexpr int_np &operator/=(const std::integral auto rhs) &noexcept
+  constexpr int_np &operator/=(const std::integral auto rhs) &noexcept(nothrow)
   {
-    value = static_cast<value_type>(value / rhs);
+    value = Overflow::div(value, rhs);
     return *this;
   }
 
-  constexpr int_np &operator%=(const std::integral auto rhs) &noexcept
+  constexpr int_np &operator%=(const std::integral auto rhs) &noexcept(nothrow)
   {
-    value = static_cast<value_type>(value / rhs);
+    value = Overflow::mod(value, rhs);
     return *this;
   }
 
@@ -187,49 +560,113 @@ public:
 
   [[nodiscard]] friend constexpr int_np operator<<(const int_np lhs, const int_np rhs) noexcept
   {
-    return from(lhs.value << rhs.value);
+    return wrapped(lhs.value << rhs.value);
   }
   [[nodiscard]] friend constexpr int_np operator>>(const int_np lhs, const int_np rhs) noexcept
   {
-    return from(lhs.value >> rhs.value);
+    return wrapped(lhs.value >> rhs.value);
   }
 
   constexpr int_np &operator<<=(const int_np rhs) &noexcept
   {
-    value = static_cast<value_type>(value << rhs.value);
+    value = detail::integral_cast<value_type>(value << rhs.value);
     return *this;
   }
 
   constexpr int_np &operator>>=(const int_np rhs) &noexcept
   {
-    value = static_cast<value_type>(value >> rhs.value);
+    value = detail::integral_cast<value_type>(value >> rhs.value);
     return *this;
   }
 
-  constexpr int_np &operator+=(const int_np rhs) &noexcept
+  constexpr int_np &operator+=(const int_np rhs) &noexcept(nothrow)
   {
-    value = static_cast<value_type>(value + rhs.value);
+    value = Overflow::add(value, rhs.value);
     return *this;
   }
 
-  constexpr int_np &operator-=(const int_np rhs) &noexcept
+  constexpr int_np &operator-=(const int_np rhs) &noexcept(nothrow)
   {
-    value = static_cast<value_type>(value - rhs.value);
+    value = Overflow::sub(value, rhs.value);
     return *this;
   }
 
-  constexpr int_np &operator/=(const int_np rhs) &noexcept
+  constexpr int_np &operator*=(const int_np rhs) &noexcept(nothrow)
   {
-    value = static_cast<value_type>(value / rhs.value);
+    value = Overflow::mul(value, rhs.value);
     return *this;
   }
 
-  constexpr int_np &operator%=(const int_np rhs) &noexcept
+  constexpr int_np &operator/=(const int_np rhs) &noexcept(nothrow)
   {
-    value = static_cast<value_type>(value / rhs.value);
+    value = Overflow::div(value, rhs.value);
     return *this;
   }
 
+  constexpr int_np &operator%=(const int_np rhs) &noexcept(nothrow)
+  {
+    value = Overflow::mod(value, rhs.value);
+    return *this;
+  }
+
+  // bit manipulation, on the two's complement representation for signed
+  // types. Everything that returns a value returns this exact type
+  [[nodiscard]] constexpr auto bits() const noexcept
+  {
+    return detail::integral_cast<std::make_unsigned_t<value_type>>(value);
+  }
+
+  [[nodiscard]] constexpr int popcount() const noexcept { return std::popcount(bits()); }
+  [[nodiscard]] constexpr int countl_zero() const noexcept { return std::countl_zero(bits()); }
+  [[nodiscard]] constexpr int countl_one() const noexcept { return std::countl_one(bits()); }
+  [[nodiscard]] constexpr int countr_zero() const noexcept { return std::countr_zero(bits()); }
+  [[nodiscard]] constexpr int countr_one() const noexcept { return std::countr_one(bits()); }
+
+  [[nodiscard]] constexpr int_np rotl(const int count) const noexcept { return wrapped(std::rotl(bits(), count)); }
+  [[nodiscard]] constexpr int_np rotr(const int count) const noexcept { return wrapped(std::rotr(bits(), count)); }
+
+  // compilers recognise this loop and emit a single bswap / rev
+  [[nodiscard]] constexpr int_np byteswap() const noexcept
+  {
+    using bits_type = decltype(bits());
+    auto source = bits();
+    bits_type result{};
+    for (std::size_t byte = 0; byte < sizeof(value_type); ++byte) {
+      const auto shifted = detail::integral_cast<bits_type>(result << CHAR_BIT);
+      result = detail::integral_cast<bits_type>(shifted | (source & 0xFFU));
+      source = detail::integral_cast<bits_type>(source >> CHAR_BIT);
+    }
+    return wrapped(result);
+  }
+
+  [[nodiscard]] constexpr bool has_single_bit() const noexcept
+    requires std::unsigned_integral<value_type>
+  {
+    return std::has_single_bit(value);
+  }
+
+  [[nodiscard]] constexpr int bit_width() const noexcept
+    requires std::unsigned_integral<value_type>
+  {
+    return detail::integral_cast<int>(std::bit_width(value));
+  }
+
+  [[nodiscard]] constexpr int_np bit_floor() const noexcept
+    requires std::unsigned_integral<value_type>
+  {
+    return int_np{ std::bit_floor(value) };
+  }
+
+  // if the next power of two is not representable the result follows the
+  // overflow policy: 0 for wrap, max() for saturate, a throw for checked
+  [[nodiscard]] constexpr int_np bit_ceil() const noexcept(nothrow)
+    requires std::unsigned_integral<value_type>
+  {
+    if (value <= 1) { return int_np{ value_type{ 1 } }; }
+    if (std::has_single_bit(value)) { return *this; }
+    return int_np{ Overflow::mul(std::bit_floor(value), value_type{ 2 }) };
+  }
+
   friend constexpr auto operator<=>(const int_np &, const int_np &) = default;
 };
 
@@ -243,6 +680,142 @@ using int_np16_t = int_np<std::int16_t>;
 using int_np32_t = int_np<std::int32_t>;
 using int_np64_t = int_np<std::int64_t>;
 
+template<std::integral Type> using int_sat = int_np<Type, overflow::saturate>;
+template<std::integral Type> using int_checked = int_np<Type, overflow::checked>;
+
+using uint_sat8_t = int_sat<std::uint8_t>;
+using uint_sat16_t = int_sat<std::uint16_t>;
+using uint_sat32_t = int_sat<std::uint32_t>;
+using uint_sat64_t = int_sat<std::uint64_t>;
+
+using int_sat8_t = int_sat<std::int8_t>;
+using int_sat16_t = int_sat<std::int16_t>;
+using int_sat32_t = int_sat<std::int32_t>;
+using int_sat64_t = int_sat<std::int64_t>;
+
+template<typename Type> inline constexpr bool is_int_np_v = false;
+template<std::integral Type, typename Overflow> inline constexpr bool is_int_np_v<int_np<Type, Overflow>> = true;
+
+template<typename Type>
+concept non_promoting_integral = is_int_np_v<std::remove_cv_t<Type>>;
+
+// int_np is layout-identical to its value_type, so buffers of int_np can be
+// memcpy'd to and from buffers of the underlying type
+template<non_promoting_integral Type>
+inline constexpr bool is_layout_identical_v =
+  sizeof(Type) == sizeof(typename Type::value_type) && alignof(Type) == alignof(typename Type::value_type)
+  && std::is_standard_layout_v<Type> && std::is_trivially_copyable_v<Type>;
+
+static_assert(is_layout_identical_v<uint_np8_t> && is_layout_identical_v<uint_np16_t>
+              && is_layout_identical_v<uint_np32_t> && is_layout_identical_v<uint_np64_t>);
+static_assert(is_layout_identical_v<int_np8_t> && is_layout_identical_v<int_np16_t>
+              && is_layout_identical_v<int_np32_t> && is_layout_identical_v<int_np64_t>);
+static_assert(is_layout_identical_v<uint_sat8_t> && is_layout_identical_v<uint_sat16_t>
+              && is_layout_identical_v<int_sat8_t> && is_layout_identical_v<int_sat16_t>);
+
+// Division by a divisor that is only known at runtime but reused many times,
+// using a precomputed multiply-high and shifts instead of a hardware divide
+// (Granlund & Montgomery, as popularised by libdivide). Results are identical
+// to operator/ and operator% for the same int_np type, including the overflow
+// policy's handling of min() / -1.
+template<non_promoting_integral Int> class fast_divider
+{
+public:
+  using value_type = typename Int::value_type;
+
+private:
+  using unsigned_type = std::make_unsigned_t<value_type>;
+  static constexpr int digits = std::numeric_limits<unsigned_type>::digits;
+
+  unsigned_type multiplier{};
+  unsigned_type magnitude{};
+  int pre_shift{};
+  int post_shift{};
+  bool negative{};
+
+  [[nodiscard]] static constexpr value_type with_sign(const unsigned_type value, const bool is_negative) noexcept
+  {
+    return detail::integral_cast<value_type>(is_negative ? detail::integral_cast<unsigned_type>(0U - value) : value);
+  }
+
+  [[nodiscard]] static constexpr unsigned_type absolute(const value_type value) noexcept
+  {
+    const auto bits = detail::integral_cast<unsigned_type>(value);
+    return detail::is_negative(value) ? detail::integral_cast<unsigned_type>(0U - bits) : bits;
+  }
+
+  [[nodiscard]] static constexpr unsigned_type multiply_high(const unsigned_type lhs, const unsigned_type rhs) noexcept
+  {
+    if constexpr (digits == 64) {
+      return detail::multiply_wide(lhs, rhs).high;
+    } else {
+      return detail::integral_cast<unsigned_type>((std::uint64_t{ lhs } * rhs) >> digits);
+    }
+  }
+
+  [[nodiscard]] constexpr unsigned_type unsigned_quotient(const unsigned_type dividend) const noexcept
+  {
+    const auto high = multiply_high(multiplier, dividend);
+    const auto sum = high + detail::integral_cast<unsigned_type>((dividend - high) >> pre_shift);
+    return detail::integral_cast<unsigned_type>(sum >> post_shift);
+  }
+
+public:
+  // throws std::domain_error for a zero divisor, whatever the overflow policy
+  constexpr explicit fast_divider(const Int divisor)
+    : magnitude{ absolute(divisor.get()) }, negative{ detail::is_negative(divisor.get()) }
+  {
+    if (magnitude == 0) { throw std::domain_error("fast_divider division by zero"); }
+
+    // multiplier = floor(2^N * (2^l - d) / d) + 1, with l = ceil(log2(d))
+    const auto below = detail::integral_cast<unsigned_type>(magnitude - 1U);
+    const auto log2_ceil = detail::integral_cast<int>(std::bit_width(below));
+    if constexpr (digits == 64) {
+      const std::uint64_t high = (log2_ceil == 64 ? 0U : (std::uint64_t{ 1 } << log2_ceil)) - magnitude;
+      multiplier = detail::divide_wide(high, 0, magnitude) + 1;
+    } else {
+      const std::uint64_t numerator = ((std::uint64_t{ 1 } << log2_ceil) - magnitude) << digits;
+      multiplier = detail::integral_cast<unsigned_type>(numerator / magnitude + 1);
+    }
+    pre_shift = log2_ceil < 1 ? log2_ceil : 1;
+    post_shift = log2_ceil > 1 ? log2_ceil - 1 : 0;
+  }
+
+  [[nodiscard]] constexpr Int divisor() const noexcept
+  {
+    return Int{ with_sign(magnitude, negative) };
+  }
+
+  [[nodiscard]] constexpr Int divide(const Int dividend) const noexcept(Int::overflow_policy::is_noexcept)
+  {
+    const auto quotient = unsigned_quotient(absolute(dividend.get()));
+    if (detail::is_negative(dividend.get()) != negative) {
+      return Int{ with_sign(quotient, true) };
+    }
+    // only min() / -1 is out of range here
+    return Int::from(quotient);
+  }
+
+  [[nodiscard]] constexpr Int remainder(const Int dividend) const noexcept
+  {
+    const auto dividend_magnitude = absolute(dividend.get());
+    const auto remainder_magnitude =
+      detail::integral_cast<unsigned_type>(dividend_magnitude - unsigned_quotient(dividend_magnitude) * magnitude);
+    return Int{ with_sign(remainder_magnitude, detail::is_negative(dividend.get())) };
+  }
+
+  [[nodiscard]] friend constexpr Int operator/(const Int dividend, const fast_divider &divider) noexcept(
+    Int::overflow_policy::is_noexcept)
+  {
+    return divider.divide(dividend);
+  }
+
+  [[nodiscard]] friend constexpr Int operator%(const Int dividend, const fast_divider &divider) noexcept
+  {
+    return divider.remainder(dividend);
+  }
+};
+
 namespace literals {
 
   consteval auto operator"" _npu8(unsigned long long val) { return uint_np8_t::from(val); }
@@ -0,0 +1,325 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_NON_PROMOTING_KERNELS_HPP
+#define LEFTICUS_TOOLS_NON_PROMOTING_KERNELS_HPP
+
+#include "non_promoting_ints.hpp"
+
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+// Element-wise operations over contiguous buffers of int_np.
+//
+// Every output element is exactly what the corresponding int_np operator would
+// produce. With GCC and clang whole blocks are processed with vector extensions
+// (relying on is_layout_identical_v); the tail, constant evaluation, the
+// checked policy and saturating multiplication use the scalar operators.
+//
+// The output may alias an input.
+
+namespace lefticus::tools::kernels {
+namespace detail {
+  template<typename Range>
+  concept input_range = std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range>
+                        && non_promoting_integral<std::ranges::range_value_t<Range>>;
+
+  template<typename Range, typename Int>
+  concept output_range = input_range<Range> && std::is_same_v<std::ranges::range_reference_t<Range>, Int &>;
+
+  enum struct operation { add, sub, mul, bit_and, bit_or, bit_xor, shift_left, shift_right };
+
+  template<operation Op, typename Int> [[nodiscard]] constexpr Int scalar(const Int lhs, const auto rhs)
+  {
+    if constexpr (Op == operation::add) {
+      return lhs + rhs;
+    } else if constexpr (Op == operation::sub) {
+      return lhs - rhs;
+    } else if constexpr (Op == operation::mul) {
+      return lhs * rhs;
+    } else if constexpr (Op == operation::bit_and) {
+      return lhs & rhs;
+    } else if constexpr (Op == operation::bit_or) {
+      return lhs | rhs;
+    } else if constexpr (Op == operation::bit_xor) {
+      return lhs ^ rhs;
+    } else if constexpr (Op == operation::shift_left) {
+      return lhs << rhs;
+    } else {
+      return lhs >> rhs;
+    }
+  }
+
+  // rhs is either a pointer to the second input or a single broadcast value
+  template<typename Int> [[nodiscard]] constexpr Int element(const Int *values, const std::size_t index) noexcept
+  {
+    return values[index];// NOLINT cppcoreguidelines-pro-bounds-pointer-arithmetic
+  }
+
+  template<typename Int> [[nodiscard]] constexpr Int element(const Int value, const std::size_t) noexcept
+  {
+    return value;
+  }
+
+#if defined(__GNUC__) || defined(__clang__)
+  inline constexpr std::size_t vector_bytes = 16;
+
+  template<typename Type> struct vector_of
+  {
+    using type [[gnu::vector_size(vector_bytes)]] = Type;
+  };
+
+  template<typename Type> using vector_t = typename vector_of<Type>::type;
+
+  template<typename Int>
+  inline constexpr bool vectorizable = !std::is_same_v<typename Int::value_type, bool>
+                                       && !std::is_same_v<typename Int::overflow_policy, overflow::checked>;
+
+  template<typename Int> using lane_vector = vector_t<std::make_unsigned_t<typename Int::value_type>>;
+
+  template<typename Int> [[nodiscard]] lane_vector<Int> load(const Int *values, const std::size_t index) noexcept
+  {
+    lane_vector<Int> result;
+    std::memcpy(&result, values + index, sizeof(result));// NOLINT cppcoreguidelines-pro-bounds-pointer-arithmetic
+    return result;
+  }
+
+  template<typename Int> [[nodiscard]] lane_vector<Int> load(const Int value, const std::size_t) noexcept
+  {
+    using lane_type = std::make_unsigned_t<typename Int::value_type>;
+    return lane_vector<Int>{} + tools::detail::integral_cast<lane_type>(value.get());
+  }
+
+  // picks `limit` for the lanes whose top bit is set in `overflowed`.
+  // limit is max() for non-negative `lhs` lanes and min() otherwise
+  template<typename Int, typename Vector>
+  [[nodiscard]] Vector saturate_signed(const Vector result, const Vector lhs, const Vector overflowed) noexcept
+  {
+    using value_type = typename Int::value_type;
+    using signed_vector = vector_t<std::make_signed_t<value_type>>;
+    constexpr int top_bit = static_cast<int>(sizeof(value_type) * CHAR_BIT) - 1;
+
+    const auto mask = __builtin_convertvector(__builtin_convertvector(overflowed, signed_vector) >> top_bit, Vector);
+    constexpr auto max = static_cast<std::make_unsigned_t<value_type>>(std::numeric_limits<value_type>::max());
+
+    const auto limit = (lhs >> top_bit) + max;
+    return (result & ~mask) | (limit & mask);
+  }
+
+  template<operation Op, typename Int, typename Vector>
+  [[nodiscard]] Vector apply(const Vector lhs, const Vector rhs) noexcept
+  {
+    constexpr bool saturating = std::is_same_v<typename Int::overflow_policy, overflow::saturate>;
+    constexpr bool is_signed = std::is_signed_v<typename Int::value_type>;
+
+    if constexpr (Op == operation::add) {
+      const Vector result = lhs + rhs;
+      if constexpr (saturating && is_signed) {
+        return saturate_signed<Int>(result, lhs, (lhs ^ result) & (rhs ^ result));
+      } else if constexpr (saturating) {
+        return result | __builtin_convertvector(result < lhs, Vector);
+      } else {
+        return result;
+      }
+    } else if constexpr (Op == operation::sub) {
+      const Vector result = lhs - rhs;
+      if constexpr (saturating && is_signed) {
+        return saturate_signed<Int>(result, lhs, (lhs ^ rhs) & (lhs ^ result));
+      } else if constexpr (saturating) {
+        return result & __builtin_convertvector(result <= lhs, Vector);
+      } else {
+        return result;
+      }
+    } else if constexpr (Op == operation::mul) {
+      return lhs * rhs;
+    } else if constexpr (Op == operation::bit_and) {
+      return lhs & rhs;
+    } else if constexpr (Op == operation::bit_or) {
+      return lhs | rhs;
+    } else {
+      return lhs ^ rhs;
+    }
+  }
+
+  template<operation Op, typename Int>
+  inline constexpr bool vectorizable_operation =
+    vectorizable<Int>
+    && !(Op == operation::mul && std::is_same_v<typename Int::overflow_policy, overflow::saturate>);
+
+  // returns the number of leading elements that were processed
+  template<operation Op, typename Int, typename Rhs>
+  std::size_t transform_vectors(const Int *lhs, const Rhs rhs, Int *out, const std::size_t size) noexcept
+  {
+    constexpr auto lanes = vector_bytes / sizeof(Int);
+    const auto blocks_end = size - size % lanes;
+    for (std::size_t index = 0; index < blocks_end; index += lanes) {
+      const auto result = apply<Op, Int>(load(lhs, index), load(rhs, index));
+      // NOLINTNEXTLINE cppcoreguidelines-pro-bounds-pointer-arithmetic
+      std::memcpy(static_cast<void *>(out + index), &result, sizeof(result));
+    }
+    return blocks_end;
+  }
+
+  template<operation Op, typename Int>
+  std::size_t shift_vectors(const Int *values, const int count, Int *out, const std::size_t size) noexcept
+  {
+    using value_type = typename Int::value_type;
+    using signed_vector = vector_t<std::make_signed_t<value_type>>;
+    using unsigned_vector = lane_vector<Int>;
+
+    constexpr auto lanes = vector_bytes / sizeof(Int);
+    const auto blocks_end = size - size % lanes;
+    for (std::size_t index = 0; index < blocks_end; index += lanes) {
+      auto block = load(values, index);
+      if constexpr (Op == operation::shift_left) {
+        block <<= count;
+      } else if constexpr (std::is_signed_v<value_type>) {
+        block = __builtin_convertvector(__builtin_convertvector(block, signed_vector) >> count, unsigned_vector);
+      } else {
+        block >>= count;
+      }
+      // NOLINTNEXTLINE cppcoreguidelines-pro-bounds-pointer-arithmetic
+      std::memcpy(static_cast<void *>(out + index), &block, sizeof(block));
+    }
+    return blocks_end;
+  }
+#endif
+
+  template<operation Op, typename Int, typename Rhs>
+  constexpr void transform(const Int *lhs, const Rhs rhs, Int *out, const std::size_t size)
+  {
+    std::size_t index = 0;
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (vectorizable_operation<Op, Int>) {
+      if (!std::is_constant_evaluated()) { index = transform_vectors<Op>(lhs, rhs, out, size); }
+    }
+#endif
+    for (; index < size; ++index) {
+      out[index] = scalar<Op>(lhs[index], element(rhs, index));// NOLINT cppcoreguidelines-pro-bounds-pointer-arithmetic
+    }
+  }
+
+  template<operation Op, typename Int>
+  constexpr void shift(const Int *values, const int count, Int *out, const std::size_t size)
+  {
+    std::size_t index = 0;
+#if defined(__GNUC__) || defined(__clang__)
+    // other shift counts keep the scalar operator's promoted semantics
+    constexpr int bits = static_cast<int>(sizeof(Int) * CHAR_BIT);
+    if constexpr (vectorizable<Int>) {
+      if (!std::is_constant_evaluated() && count >= 0 && count < bits) {
+        index = shift_vectors<Op>(values, count, out, size);
+      }
+    }
+#endif
+    for (; index < size; ++index) {
+      out[index] = scalar<Op>(values[index], count);// NOLINT cppcoreguidelines-pro-bounds-pointer-arithmetic
+    }
+  }
+
+  constexpr void check_sizes(const std::size_t input, const std::size_t output)
+  {
+    if (input != output) { throw std::invalid_argument("kernel input and output sizes do not match"); }
+  }
+
+  template<operation Op, typename Lhs, typename Rhs, typename Out>
+  constexpr void binary(const Lhs &lhs, const Rhs &rhs, Out &&out)
+  {
+    check_sizes(std::ranges::size(lhs), std::ranges::size(out));
+    if constexpr (input_range<Rhs>) {
+      check_sizes(std::ranges::size(rhs), std::ranges::size(out));
+      transform<Op>(std::ranges::data(lhs), std::ranges::data(rhs), std::ranges::data(out), std::ranges::size(out));
+    } else {
+      transform<Op>(std::ranges::data(lhs), rhs, std::ranges::data(out), std::ranges::size(out));
+    }
+  }
+}// namespace detail
+
+// `rhs` is either a second buffer of the same size or a single value applied to every element
+template<typename Rhs, typename Lhs>
+concept binary_operands = detail::input_range<Rhs> || std::is_same_v<Rhs, std::ranges::range_value_t<Lhs>>;
+
+template<detail::input_range Lhs, binary_operands<Lhs> Rhs, detail::output_range<std::ranges::range_value_t<Lhs>> Out>
+constexpr void add(const Lhs &lhs, const Rhs &rhs, Out &&out)
+{
+  detail::binary<detail::operation::add>(lhs, rhs, out);
+}
+
+template<detail::input_range Lhs, binary_operands<Lhs> Rhs, detail::output_range<std::ranges::range_value_t<Lhs>> Out>
+constexpr void sub(const Lhs &lhs, const Rhs &rhs, Out &&out)
+{
+  detail::binary<detail::operation::sub>(lhs, rhs, out);
+}
+
+template<detail::input_range Lhs, binary_operands<Lhs> Rhs, detail::output_range<std::ranges::range_value_t<Lhs>> Out>
+constexpr void mul(const Lhs &lhs, const Rhs &rhs, Out &&out)
+{
+  detail::binary<detail::operation::mul>(lhs, rhs, out);
+}
+
+template<detail::input_range Lhs, binary_operands<Lhs> Rhs, detail::output_range<std::ranges::range_value_t<Lhs>> Out>
+constexpr void bit_and(const Lhs &lhs, const Rhs &rhs, Out &&out)
+{
+  detail::binary<detail::operation::bit_and>(lhs, rhs, out);
+}
+
+template<detail::input_range Lhs, binary_operands<Lhs> Rhs, detail::output_range<std::ranges::range_value_t<Lhs>> Out>
+constexpr void bit_or(const Lhs &lhs, const Rhs &rhs, Out &&out)
+{
+  detail::binary<detail::operation::bit_or>(lhs, rhs, out);
+}
+
+template<detail::input_range Lhs, binary_operands<Lhs> Rhs, detail::output_range<std::ranges::range_value_t<Lhs>> Out>
+constexpr void bit_xor(const Lhs &lhs, const Rhs &rhs, Out &&out)
+{
+  detail::binary<detail::operation::bit_xor>(lhs, rhs, out);
+}
+
+template<detail::input_range In, detail::output_range<std::ranges::range_value_t<In>> Out>
+constexpr void shift_left(const In &values, const int count, Out &&out)
+{
+  detail::check_sizes(std::ranges::size(values), std::ranges::size(out));
+  detail::shift<detail::operation::shift_left>(
+    std::ranges::data(values), count, std::ranges::data(out), std::ranges::size(out));
+}
+
+template<detail::input_range In, detail::output_range<std::ranges::range_value_t<In>> Out>
+constexpr void shift_right(const In &values, const int count, Out &&out)
+{
+  detail::check_sizes(std::ranges::size(values), std::ranges::size(out));
+  detail::shift<detail::operation::shift_right>(
+    std::ranges::data(values), count, std::ranges::data(out), std::ranges::size(out));
+}
+}// namespace lefticus::tools::kernels
+
+#endif
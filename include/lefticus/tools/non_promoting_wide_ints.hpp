@@ -0,0 +1,407 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_NON_PROMOTING_WIDE_INTS_HPP
+#define LEFTICUS_TOOLS_NON_PROMOTING_WIDE_INTS_HPP
+
+#include "non_promoting_ints.hpp"
+
+#include <array>
+#include <climits>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace lefticus::tools {
+namespace detail {
+  // lhs + rhs + carry, updating carry
+  [[nodiscard]] constexpr std::uint64_t add_with_carry(const std::uint64_t lhs,
+    const std::uint64_t rhs,
+    bool &carry) noexcept
+  {
+#if defined(__clang__)
+    if (!std::is_constant_evaluated()) {
+      unsigned long long carry_out = 0;
+      const std::uint64_t result = __builtin_addcll(lhs, rhs, carry ? 1ULL : 0ULL, &carry_out);
+      carry = carry_out != 0;
+      return result;
+    }
+#elif defined(_MSC_VER) && defined(_M_X64)
+    if (!std::is_constant_evaluated()) {
+      unsigned long long result = 0;
+      carry = _addcarry_u64(carry ? 1 : 0, lhs, rhs, &result) != 0;
+      return result;
+    }
+#endif
+    // GCC recognises this and emits an add-with-carry chain
+    const std::uint64_t partial = lhs + rhs;
+    const std::uint64_t result = partial + (carry ? 1U : 0U);
+    carry = (partial < lhs) || (result < partial);
+    return result;
+  }
+
+  // lhs - rhs - borrow, updating borrow
+  [[nodiscard]] constexpr std::uint64_t sub_with_borrow(const std::uint64_t lhs,
+    const std::uint64_t rhs,
+    bool &borrow) noexcept
+  {
+#if defined(__clang__)
+    if (!std::is_constant_evaluated()) {
+      unsigned long long borrow_out = 0;
+      const std::uint64_t result = __builtin_subcll(lhs, rhs, borrow ? 1ULL : 0ULL, &borrow_out);
+      borrow = borrow_out != 0;
+      return result;
+    }
+#elif defined(_MSC_VER) && defined(_M_X64)
+    if (!std::is_constant_evaluated()) {
+      unsigned long long result = 0;
+      borrow = _subborrow_u64(borrow ? 1 : 0, lhs, rhs, &result) != 0;
+      return result;
+    }
+#endif
+    const std::uint64_t partial = lhs - rhs;
+    const std::uint64_t result = partial - (borrow ? 1U : 0U);
+    borrow = (lhs < rhs) || (partial < result);
+    return result;
+  }
+}// namespace detail
+
+// Fixed width unsigned integer made of 64 bit words, least significant word
+// first. Like int_np, every operation stays in the exact type and wraps
+// modulo 2^Bits. Shifting by Bits or more yields zero.
+template<std::size_t Bits>
+  requires(Bits >= 128 && Bits % 64 == 0)
+struct uint_np
+{
+  using word_type = std::uint64_t;
+  static constexpr std::size_t word_bits = 64;
+  static constexpr std::size_t word_count = Bits / word_bits;
+  using words_type = std::array<word_type, word_count>;
+
+private:
+  words_type value{};
+
+public:
+  constexpr uint_np() noexcept = default;
+
+  constexpr explicit uint_np(const words_type &words_) noexcept : value{ words_ } {}
+
+  // negative values are sign extended, so from(-1) is all ones
+  [[nodiscard]] static constexpr uint_np from(const std::integral auto value) noexcept
+  {
+    uint_np result;
+    result.value[0] = detail::integral_cast<word_type>(value);
+    if (detail::is_negative(value)) {
+      for (std::size_t index = 1; index < word_count; ++index) { result.value[index] = ~word_type{}; }
+    }
+    return result;
+  }
+
+  [[nodiscard]] constexpr const words_type &words() const noexcept { return value; }
+
+  [[nodiscard]] constexpr word_type word(const std::size_t index) const noexcept { return value[index]; }
+
+  [[nodiscard]] friend constexpr uint_np operator+(const uint_np &lhs, const uint_np &rhs) noexcept
+  {
+    uint_np result;
+    bool carry = false;
+    for (std::size_t index = 0; index < word_count; ++index) {
+      result.value[index] = detail::add_with_carry(lhs.value[index], rhs.value[index], carry);
+    }
+    return result;
+  }
+
+  [[nodiscard]] friend constexpr uint_np operator-(const uint_np &lhs, const uint_np &rhs) noexcept
+  {
+    uint_np result;
+    bool borrow = false;
+    for (std::size_t index = 0; index < word_count; ++index) {
+      result.value[index] = detail::sub_with_borrow(lhs.value[index], rhs.value[index], borrow);
+    }
+    return result;
+  }
+
+  // schoolbook multiplication, only computing the words that are kept
+  [[nodiscard]] friend constexpr uint_np operator*(const uint_np &lhs, const uint_np &rhs) noexcept
+  {
+    uint_np result;
+    for (std::size_t lhs_index = 0; lhs_index < word_count; ++lhs_index) {
+      word_type carry = 0;
+      for (std::size_t rhs_index = 0; lhs_index + rhs_index < word_count; ++rhs_index) {
+        const auto product = detail::multiply_wide(lhs.value[lhs_index], rhs.value[rhs_index]);
+        bool low_carry = false;
+        const word_type low = detail::add_with_carry(product.low, carry, low_carry);
+        bool sum_carry = false;
+        auto &target = result.value[lhs_index + rhs_index];
+        target = detail::add_with_carry(target, low, sum_carry);
+        carry = product.high + (low_carry ? 1U : 0U) + (sum_carry ? 1U : 0U);
+      }
+    }
+    return result;
+  }
+
+  [[nodiscard]] friend constexpr uint_np operator&(const uint_np &lhs, const uint_np &rhs) noexcept
+  {
+    uint_np result;
+    for (std::size_t index = 0; index < word_count; ++index) {
+      result.value[index] = lhs.value[index] & rhs.value[index];
+    }
+    return result;
+  }
+
+  [[nodiscard]] friend constexpr uint_np operator|(const uint_np &lhs, const uint_np &rhs) noexcept
+  {
+    uint_np result;
+    for (std::size_t index = 0; index < word_count; ++index) {
+      result.value[index] = lhs.value[index] | rhs.value[index];
+    }
+    return result;
+  }
+
+  [[nodiscard]] friend constexpr uint_np operator^(const uint_np &lhs, const uint_np &rhs) noexcept
+  {
+    uint_np result;
+    for (std::size_t index = 0; index < word_count; ++index) {
+      result.value[index] = lhs.value[index] ^ rhs.value[index];
+    }
+    return result;
+  }
+
+  [[nodiscard]] constexpr uint_np operator~() const noexcept
+  {
+    uint_np result;
+    for (std::size_t index = 0; index < word_count; ++index) { result.value[index] = ~value[index]; }
+    return result;
+  }
+
+  [[nodiscard]] friend constexpr uint_np operator<<(const uint_np &lhs, const std::size_t count) noexcept
+  {
+    uint_np result;
+    if (count >= Bits) { return result; }
+    const std::size_t word_shift = count / word_bits;
+    const std::size_t bit_shift = count % word_bits;
+    for (std::size_t index = word_count; index-- > word_shift;) {
+      const std::size_t source = index - word_shift;
+      result.value[index] = lhs.value[source] << bit_shift;
+      if (bit_shift != 0 && source > 0) { result.value[index] |= lhs.value[source - 1] >> (word_bits - bit_shift); }
+    }
+    return result;
+  }
+
+  [[nodiscard]] friend constexpr uint_np operator>>(const uint_np &lhs, const std::size_t count) noexcept
+  {
+    uint_np result;
+    if (count >= Bits) { return result; }
+    const std::size_t word_shift = count / word_bits;
+    const std::size_t bit_shift = count % word_bits;
+    for (std::size_t index = 0; index + word_shift < word_count; ++index) {
+      const std::size_t source = index + word_shift;
+      result.value[index] = lhs.value[source] >> bit_shift;
+      if (bit_shift != 0 && source + 1 < word_count) {
+        result.value[index] |= lhs.value[source + 1] << (word_bits - bit_shift);
+      }
+    }
+    return result;
+  }
+
+  constexpr uint_np &operator+=(const uint_np &rhs) &noexcept { return *this = *this + rhs; }
+  constexpr uint_np &operator-=(const uint_np &rhs) &noexcept { return *this = *this - rhs; }
+  constexpr uint_np &operator*=(const uint_np &rhs) &noexcept { return *this = *this * rhs; }
+  constexpr uint_np &operator&=(const uint_np &rhs) &noexcept { return *this = *this & rhs; }
+  constexpr uint_np &operator|=(const uint_np &rhs) &noexcept { return *this = *this | rhs; }
+  constexpr uint_np &operator^=(const uint_np &rhs) &noexcept { return *this = *this ^ rhs; }
+  constexpr uint_np &operator<<=(const std::size_t count) &noexcept { return *this = *this << count; }
+  constexpr uint_np &operator>>=(const std::size_t count) &noexcept { return *this = *this >> count; }
+
+  constexpr uint_np &operator++() &noexcept { return *this += from(1); }
+  constexpr uint_np &operator--() &noexcept { return *this -= from(1); }
+
+  // you shouldn't use post-increment unless you plan to use the
+  // result. So I made it [[nodiscard]] - Jason
+  [[nodiscard]] constexpr uint_np operator++(int) &noexcept
+  {
+    const uint_np old = *this;
+    ++*this;
+    return old;
+  }
+
+  [[nodiscard]] constexpr uint_np operator--(int) &noexcept
+  {
+    const uint_np old = *this;
+    --*this;
+    return old;
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const uint_np &, const uint_np &) = default;
+
+  [[nodiscard]] friend constexpr std::strong_ordering operator<=>(const uint_np &lhs, const uint_np &rhs) noexcept
+  {
+    for (std::size_t index = word_count; index-- > 0;) {
+      if (lhs.value[index] != rhs.value[index]) { return lhs.value[index] <=> rhs.value[index]; }
+    }
+    return std::strong_ordering::equal;
+  }
+};
+
+using uint_np128_t = uint_np<128>;
+using uint_np256_t = uint_np<256>;
+
+// Packed lanes in one machine word (SWAR). Lane 0 is the least significant.
+// Arithmetic is lane-wise and wraps inside each lane, so nothing carries from
+// one lane into the next. Shifting by the lane width or more yields zero.
+template<std::unsigned_integral Lane, std::unsigned_integral Word>
+  requires(sizeof(Word) > sizeof(Lane) && sizeof(Word) % sizeof(Lane) == 0)
+struct swar
+{
+  using lane_type = Lane;
+  using word_type = Word;
+  static constexpr std::size_t lane_count = sizeof(Word) / sizeof(Lane);
+  static constexpr std::size_t lane_bits = sizeof(Lane) * CHAR_BIT;
+
+private:
+  word_type value;
+
+  [[nodiscard]] static constexpr word_type word(const std::integral auto result) noexcept
+  {
+    return detail::integral_cast<word_type>(result);
+  }
+
+  // lane value repeated into every lane
+  [[nodiscard]] static constexpr word_type broadcast(const lane_type lane) noexcept
+  {
+    constexpr auto ones = word(std::numeric_limits<word_type>::max() / std::numeric_limits<lane_type>::max());
+    return word(ones * lane);
+  }
+
+  static constexpr word_type high_bits = broadcast(static_cast<lane_type>(lane_type{ 1 } << (lane_bits - 1)));
+
+public:
+  constexpr explicit swar(const word_type word_) noexcept : value{ word_ } {}
+
+  [[nodiscard]] static constexpr swar splat(const lane_type lane) noexcept { return swar{ broadcast(lane) }; }
+
+  [[nodiscard]] static constexpr swar from_lanes(const std::array<lane_type, lane_count> &lanes) noexcept
+  {
+    word_type result{};
+    for (std::size_t index = lane_count; index-- > 0;) { result = word((result << lane_bits) | lanes[index]); }
+    return swar{ result };
+  }
+
+  [[nodiscard]] constexpr word_type get() const noexcept { return value; }
+
+  [[nodiscard]] constexpr int_np<lane_type> lane(const std::size_t index) const noexcept
+  {
+    return int_np<lane_type>::from(value >> (index * lane_bits));
+  }
+
+  [[nodiscard]] constexpr std::array<lane_type, lane_count> lanes() const noexcept
+  {
+    std::array<lane_type, lane_count> result{};
+    for (std::size_t index = 0; index < lane_count; ++index) { result[index] = lane(index).get(); }
+    return result;
+  }
+
+  // sum of all lanes, which cannot overflow the word
+  [[nodiscard]] constexpr word_type horizontal_sum() const noexcept
+  {
+    word_type result{};
+    for (std::size_t index = 0; index < lane_count; ++index) { result = word(result + lane(index).get()); }
+    return result;
+  }
+
+  // add the low bits of every lane, then patch the top bit of each lane in
+  // with xor so no carry crosses a lane boundary
+  [[nodiscard]] friend constexpr swar operator+(const swar lhs, const swar rhs) noexcept
+  {
+    const auto low = word((lhs.value & word(~high_bits)) + (rhs.value & word(~high_bits)));
+    return swar{ word(low ^ ((lhs.value ^ rhs.value) & high_bits)) };
+  }
+
+  [[nodiscard]] friend constexpr swar operator-(const swar lhs, const swar rhs) noexcept
+  {
+    const auto low = word((lhs.value | high_bits) - (rhs.value & word(~high_bits)));
+    return swar{ word(low ^ ((lhs.value ^ word(~rhs.value)) & high_bits)) };
+  }
+
+  [[nodiscard]] friend constexpr swar operator&(const swar lhs, const swar rhs) noexcept
+  {
+    return swar{ word(lhs.value & rhs.value) };
+  }
+
+  [[nodiscard]] friend constexpr swar operator|(const swar lhs, const swar rhs) noexcept
+  {
+    return swar{ word(lhs.value | rhs.value) };
+  }
+
+  [[nodiscard]] friend constexpr swar operator^(const swar lhs, const swar rhs) noexcept
+  {
+    return swar{ word(lhs.value ^ rhs.value) };
+  }
+
+  [[nodiscard]] constexpr swar operator~() const noexcept { return swar{ word(~value) }; }
+
+  [[nodiscard]] friend constexpr swar operator<<(const swar lhs, const std::size_t count) noexcept
+  {
+    if (count >= lane_bits) { return swar{ word_type{} }; }
+    const auto kept = broadcast(static_cast<lane_type>(std::numeric_limits<lane_type>::max() << count));
+    return swar{ word(word(lhs.value << count) & kept) };
+  }
+
+  [[nodiscard]] friend constexpr swar operator>>(const swar lhs, const std::size_t count) noexcept
+  {
+    if (count >= lane_bits) { return swar{ word_type{} }; }
+    const auto kept = broadcast(static_cast<lane_type>(std::numeric_limits<lane_type>::max() >> count));
+    return swar{ word(word(lhs.value >> count) & kept) };
+  }
+
+  constexpr swar &operator+=(const swar rhs) &noexcept { return *this = *this + rhs; }
+  constexpr swar &operator-=(const swar rhs) &noexcept { return *this = *this - rhs; }
+  constexpr swar &operator&=(const swar rhs) &noexcept { return *this = *this & rhs; }
+  constexpr swar &operator|=(const swar rhs) &noexcept { return *this = *this | rhs; }
+  constexpr swar &operator^=(const swar rhs) &noexcept { return *this = *this ^ rhs; }
+  constexpr swar &operator<<=(const std::size_t count) &noexcept { return *this = *this << count; }
+  constexpr swar &operator>>=(const std::size_t count) &noexcept { return *this = *this >> count; }
+
+  [[nodiscard]] friend constexpr bool operator==(const swar, const swar) noexcept = default;
+};
+
+using u8x4_np = swar<std::uint8_t, std::uint32_t>;
+using u8x8_np = swar<std::uint8_t, std::uint64_t>;
+using u16x2_np = swar<std::uint16_t, std::uint32_t>;
+using u16x4_np = swar<std::uint16_t, std::uint64_t>;
+using u32x2_np = swar<std::uint32_t, std::uint64_t>;
+}// namespace lefticus::tools
+
+#endif
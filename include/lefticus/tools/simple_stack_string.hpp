@@ -271,6 +271,13 @@ template<typename CharType, std::size_t Size>
   return lhs == static_cast<std::basic_string_view<CharType>>(rhs);
 }
 
+template<typename CharType, std::size_t LHSSize, std::size_t RHSSize>
+[[nodiscard]] constexpr bool operator==(const basic_simple_stack_string<CharType, LHSSize> &lhs,
+  const basic_simple_stack_string<CharType, RHSSize> &rhs) noexcept
+{
+  return static_cast<std::basic_string_view<CharType>>(lhs) == static_cast<std::basic_string_view<CharType>>(rhs);
+}
+
 
 template<typename CharType, std::size_t LHSSize, std::size_t RHSSize>
 [[nodiscard]] constexpr basic_simple_stack_string<CharType, LHSSize + RHSSize - 1>
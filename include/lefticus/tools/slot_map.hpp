@@ -0,0 +1,238 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_SLOT_MAP_HPP
+#define LEFTICUS_TOOLS_SLOT_MAP_HPP
+
+#include "simple_stack_vector.hpp"
+#include "strong_types.hpp"
+#include "strong_vector.hpp"
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace lefticus::tools {
+
+// An ID handed out by slot_map<Value, Tag>. The generation changes every
+// time its slot is reused, so an ID outlives the value it refers to safely.
+template<typename Tag> struct slot_map_id
+{
+  std::uint32_t index{};
+  std::uint32_t generation{};
+
+  [[nodiscard]] constexpr auto operator<=>(const slot_map_id &) const noexcept = default;
+};
+
+// Storage policies for slot_map, which needs a container per member
+struct vector_storage
+{
+  template<typename Value> using type = std::vector<Value>;
+};
+
+template<std::size_t Capacity> struct simple_stack_storage
+{
+  template<typename Value> using type = simple_stack_vector<Value, Capacity>;
+};
+
+// Dense storage addressed by generational IDs: lookup is two array
+// indexings, values stay contiguous for iteration, and erase moves the last
+// value into the hole. operator[] only verifies the generation in builds
+// without NDEBUG; find(), at() and contains() always do.
+template<typename Value, typename Tag, typename Storage = vector_storage> class slot_map
+{
+  struct position_tag;
+  using position = strong_index<position_tag>;
+
+  // a free slot's position links to the next free slot. The generation is
+  // odd while the slot is occupied, so stale and never-issued IDs both miss.
+  struct slot
+  {
+    std::uint32_t position{};
+    std::uint32_t generation{};
+  };
+
+  template<typename Type> using container = typename Storage::template type<Type>;
+
+public:
+  using id_type = slot_map_id<Tag>;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename container<Value>::iterator;
+  using const_iterator = typename container<Value>::const_iterator;
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return values.empty(); }
+  [[nodiscard]] constexpr size_type size() const noexcept { return values.size(); }
+
+  // iterates the values densely, in no particular order
+  [[nodiscard]] constexpr iterator begin() noexcept { return values.begin(); }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return values.begin(); }
+  [[nodiscard]] constexpr iterator end() noexcept { return values.end(); }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return values.end(); }
+
+  template<typename... Param> constexpr id_type emplace(Param &&...param)
+  {
+    if (free_head == no_free_slot) {
+      if (slots.size() >= no_free_slot) { throw std::length_error("slot_map is full"); }
+      slots.emplace_back(slot{ no_free_slot, 0 });
+      free_head = static_cast<std::uint32_t>(slots.size() - 1);
+    }
+
+    const auto index = free_head;
+    const auto dense = values.emplace_back(std::forward<Param>(param)...);
+    try {
+      owners.emplace_back(index);
+    } catch (...) {
+      values.pop_back();
+      throw;
+    }
+
+    auto &current = slots[index];
+    free_head = current.position;
+    current.position = dense.get();
+    ++current.generation;
+    return id_type{ index, current.generation };
+  }
+
+  constexpr id_type insert(const value_type &value) { return emplace(value); }
+  constexpr id_type insert(value_type &&value) { return emplace(std::move(value)); }
+
+  [[nodiscard]] constexpr bool contains(const id_type id) const noexcept
+  {
+    return id.index < slots.size() && slots[id.index].generation == id.generation && (id.generation & 1U) == 1U;
+  }
+
+  [[nodiscard]] constexpr value_type *find(const id_type id) noexcept
+  {
+    return contains(id) ? &values[position{ slots[id.index].position }] : nullptr;
+  }
+
+  [[nodiscard]] constexpr const value_type *find(const id_type id) const noexcept
+  {
+    return contains(id) ? &values[position{ slots[id.index].position }] : nullptr;
+  }
+
+  [[nodiscard]] constexpr reference operator[](const id_type id) noexcept(!debug_validation)
+  {
+    if constexpr (debug_validation) { check(id); }
+    return values[position{ slots[id.index].position }];
+  }
+
+  [[nodiscard]] constexpr const_reference operator[](const id_type id) const noexcept(!debug_validation)
+  {
+    if constexpr (debug_validation) { check(id); }
+    return values[position{ slots[id.index].position }];
+  }
+
+  [[nodiscard]] constexpr reference at(const id_type id)
+  {
+    check(id);
+    return values[position{ slots[id.index].position }];
+  }
+
+  [[nodiscard]] constexpr const_reference at(const id_type id) const
+  {
+    check(id);
+    return values[position{ slots[id.index].position }];
+  }
+
+  // returns false if id was already erased
+  constexpr bool erase(const id_type id)
+  {
+    if (!contains(id)) { return false; }
+
+    auto &erased = slots[id.index];
+    const position hole{ erased.position };
+    const position last{ static_cast<std::uint32_t>(values.size() - 1) };
+    if (hole.get() != last.get()) {
+      values[hole] = std::move(values[last]);
+      owners[hole] = owners[last];
+      slots[owners[hole]].position = hole.get();
+    }
+    values.pop_back();
+    owners.pop_back();
+
+    ++erased.generation;
+    erased.position = free_head;
+    free_head = id.index;
+    return true;
+  }
+
+  // invalidates every outstanding ID
+  constexpr void clear()
+  {
+    for (std::uint32_t index = 0; index < slots.size(); ++index) {
+      if (auto &current = slots[index]; (current.generation & 1U) == 1U) {
+        ++current.generation;
+        current.position = free_head;
+        free_head = index;
+      }
+    }
+    values.clear();
+    owners.clear();
+  }
+
+  constexpr void reserve(const size_type new_capacity)
+  {
+    values.reserve(new_capacity);
+    owners.reserve(new_capacity);
+    slots.reserve(new_capacity);
+  }
+
+  // the ID of the value at `begin() + offset`
+  [[nodiscard]] constexpr id_type id_at(const size_type offset) const
+  {
+    const auto index = owners.at(position{ static_cast<std::uint32_t>(offset) });
+    return id_type{ index, slots[index].generation };
+  }
+
+private:
+  static constexpr std::uint32_t no_free_slot = std::numeric_limits<std::uint32_t>::max();
+
+  constexpr void check(const id_type id) const
+  {
+    if (!contains(id)) { throw std::out_of_range("stale or invalid slot_map id"); }
+  }
+
+  strong_vector<position, Value, container<Value>> values;
+  strong_vector<position, std::uint32_t, container<std::uint32_t>> owners;
+  container<slot> slots;
+  std::uint32_t free_head = no_free_slot;
+};
+
+template<typename Value, typename Tag, std::size_t Capacity>
+using simple_stack_slot_map = slot_map<Value, Tag, simple_stack_storage<Capacity>>;
+
+}// namespace lefticus::tools
+
+#endif// LEFTICUS_TOOLS_SLOT_MAP_HPP
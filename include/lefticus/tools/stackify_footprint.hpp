@@ -0,0 +1,269 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_STACKIFY_FOOTPRINT_HPP
+#define LEFTICUS_TOOLS_STACKIFY_FOOTPRINT_HPP
+
+#include "simple_stack_vector.hpp"
+#include "static_views.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iomanip>
+#include <optional>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+
+namespace lefticus::tools {
+
+// Where the static memory of a stackified value goes, one entry per level
+// of container nesting. Wrappers (optional, variant, tuple, array and
+// aggregates) are transparent, their contents are reported at the level
+// of the wrapper itself. A disengaged optional still reserves the storage
+// of an empty value, and a variant reserves that of its largest alternative.
+struct footprint_level
+{
+  // largest capacity of any container at this level
+  std::size_t capacity{};
+  std::size_t containers{};
+  std::size_t elements_used{};
+  std::size_t bytes_used{};
+  std::size_t bytes_reserved{};
+};
+
+static constexpr std::size_t max_footprint_depth = 16;
+
+struct footprint_report
+{
+  simple_stack_vector<footprint_level, max_footprint_depth> levels;
+
+  // sizeof the minimized result
+  std::size_t total_size{};
+
+  // sizeof the `stackify<MaxSize>` value it was minimized from
+  std::size_t input_size{};
+
+  // negative if minimizing made the value bigger
+  [[nodiscard]] constexpr std::ptrdiff_t bytes_saved() const noexcept
+  {
+    return static_cast<std::ptrdiff_t>(input_size) - static_cast<std::ptrdiff_t>(total_size);
+  }
+};
+
+
+constexpr void measure_footprint(const auto &, footprint_report &, std::size_t);
+template<typename CharType, std::size_t CurSize>
+constexpr void
+  measure_footprint(const basic_simple_stack_string<CharType, CurSize> &, footprint_report &, std::size_t);
+template<typename Value, std::size_t CurSize>
+constexpr void measure_footprint(const simple_stack_vector<Value, CurSize> &, footprint_report &, std::size_t);
+template<typename Key, typename Value, std::size_t CurSize>
+constexpr void measure_footprint(const simple_stack_flat_map<Key, Value, CurSize> &, footprint_report &, std::size_t);
+template<typename Value>
+constexpr void measure_footprint(const std::optional<Value> &, footprint_report &, std::size_t);
+template<typename Value, std::size_t Size>
+constexpr void measure_footprint(const std::array<Value, Size> &, footprint_report &, std::size_t);
+template<typename... Value>
+constexpr void measure_footprint(const std::tuple<Value...> &, footprint_report &, std::size_t);
+template<typename... Value>
+constexpr void measure_footprint(const std::variant<Value...> &, footprint_report &, std::size_t);
+template<template<typename...> typename Aggregate, typename... Member>
+  requires aggregate_of<Aggregate<Member...>, Member...>
+constexpr void measure_footprint(const Aggregate<Member...> &, footprint_report &, std::size_t);
+
+
+// records one container at `depth`
+constexpr void record_footprint(footprint_report &report,
+  const std::size_t depth,
+  const std::size_t capacity,
+  const std::size_t size,
+  const std::size_t element_size)
+{
+  while (report.levels.size() <= depth) { report.levels.emplace_back(); }
+
+  auto &level = report.levels[depth];
+  level.capacity = std::max(level.capacity, capacity);
+  ++level.containers;
+  level.elements_used += size;
+  level.bytes_used += size * element_size;
+  level.bytes_reserved += capacity * element_size;
+}
+
+// adds the levels of `other` from `depth` down into `report`
+constexpr void merge_footprint(footprint_report &report, const footprint_report &other, const std::size_t depth)
+{
+  for (std::size_t index = depth; index < other.levels.size(); ++index) {
+    while (report.levels.size() <= index) { report.levels.emplace_back(); }
+
+    auto &level = report.levels[index];
+    const auto &from = other.levels[index];
+    level.capacity = std::max(level.capacity, from.capacity);
+    level.containers += from.containers;
+    level.elements_used += from.elements_used;
+    level.bytes_used += from.bytes_used;
+    level.bytes_reserved += from.bytes_reserved;
+  }
+}
+
+// the storage a wrapper sets aside for a Value it does not currently hold
+template<typename Value> constexpr void measure_reserved(footprint_report &report, const std::size_t depth)
+{
+  if constexpr (std::is_default_constructible_v<Value>) { measure_footprint(Value{}, report, depth); }
+}
+
+constexpr void measure_footprint(const auto &, footprint_report &, std::size_t) {}
+
+template<typename CharType, std::size_t CurSize>
+constexpr void measure_footprint(const basic_simple_stack_string<CharType, CurSize> &string,
+  footprint_report &report,
+  const std::size_t depth)
+{
+  record_footprint(report, depth, string.capacity(), string.size(), sizeof(CharType));
+}
+
+template<typename Value, std::size_t CurSize>
+constexpr void
+  measure_footprint(const simple_stack_vector<Value, CurSize> &vec, footprint_report &report, const std::size_t depth)
+{
+  record_footprint(report, depth, vec.capacity(), vec.size(), sizeof(Value));
+  for (const auto &value : vec) { measure_footprint(value, report, depth + 1); }
+}
+
+template<typename Key, typename Value, std::size_t CurSize>
+constexpr void measure_footprint(const simple_stack_flat_map<Key, Value, CurSize> &map,
+  footprint_report &report,
+  const std::size_t depth)
+{
+  using value_type = typename simple_stack_flat_map<Key, Value, CurSize>::value_type;
+  record_footprint(report, depth, map.max_size(), map.size(), sizeof(value_type));
+  for (const auto &[key, value] : map) {
+    measure_footprint(key, report, depth + 1);
+    measure_footprint(value, report, depth + 1);
+  }
+}
+
+template<typename Value>
+constexpr void measure_footprint(const std::optional<Value> &value, footprint_report &report, const std::size_t depth)
+{
+  if (value) {
+    measure_footprint(*value, report, depth);
+  } else {
+    measure_reserved<Value>(report, depth);
+  }
+}
+
+template<typename Value, std::size_t Size>
+constexpr void
+  measure_footprint(const std::array<Value, Size> &values, footprint_report &report, const std::size_t depth)
+{
+  for (const auto &value : values) { measure_footprint(value, report, depth); }
+}
+
+template<typename... Value>
+constexpr void measure_footprint(const std::tuple<Value...> &values, footprint_report &report, const std::size_t depth)
+{
+  std::apply([&](const auto &...value) { (measure_footprint(value, report, depth), ...); }, values);
+}
+
+template<typename... Value>
+constexpr void measure_footprint(const std::variant<Value...> &value, footprint_report &report, const std::size_t depth)
+{
+  footprint_report active;
+  std::visit([&](const auto &alternative) { measure_footprint(alternative, active, depth); }, value);
+
+  // the usage is the active alternative's, the reservation is the largest one's
+  const auto reserve = [&](const footprint_report &alternative) {
+    for (std::size_t index = depth; index < alternative.levels.size(); ++index) {
+      while (active.levels.size() <= index) { active.levels.emplace_back(); }
+      auto &level = active.levels[index];
+      level.capacity = std::max(level.capacity, alternative.levels[index].capacity);
+      level.bytes_reserved = std::max(level.bytes_reserved, alternative.levels[index].bytes_reserved);
+    }
+  };
+  (
+    [&] {
+      footprint_report alternative;
+      measure_reserved<Value>(alternative, depth);
+      reserve(alternative);
+    }(),
+    ...);
+
+  merge_footprint(report, active, depth);
+}
+
+template<template<typename...> typename Aggregate, typename... Member>
+  requires aggregate_of<Aggregate<Member...>, Member...>
+constexpr void measure_footprint(const Aggregate<Member...> &value, footprint_report &report, const std::size_t depth)
+{
+  std::apply([&](const auto &...member) { (measure_footprint(member, report, depth), ...); },
+    tie_members<sizeof...(Member)>(value));
+}
+
+
+// Reports the footprint of `minimized_stackify<MaxSize>(callable)`
+template<std::size_t MaxSize, typename Callable>
+constexpr footprint_report minimized_stackify_footprint(Callable callable)
+{
+  constexpr auto stackified{ stackify<MaxSize>(callable()) };
+  constexpr auto sizes{ max_element_size(stackified) };
+  const auto minimized = resize<sizes>(stackified);
+
+  footprint_report report;
+  measure_footprint(minimized, report, 0);
+  report.total_size = sizeof(minimized);
+  report.input_size = sizeof(stackified);
+  return report;
+}
+
+
+inline std::ostream &operator<<(std::ostream &out, const footprint_report &report)
+{
+  constexpr int width = 16;
+
+  out << std::setw(width) << "level" << std::setw(width) << "capacity" << std::setw(width) << "containers"
+      << std::setw(width) << "used" << std::setw(width) << "bytes used" << std::setw(width) << "bytes reserved" << '\n';
+
+  std::size_t depth = 0;
+  for (const auto &level : report.levels) {
+    out << std::setw(width) << depth++ << std::setw(width) << level.capacity << std::setw(width) << level.containers
+        << std::setw(width) << level.elements_used << std::setw(width) << level.bytes_used << std::setw(width)
+        << level.bytes_reserved << '\n';
+  }
+
+  const auto saved = report.bytes_saved();
+  out << "sizeof: " << report.total_size << " (stackified input: " << report.input_size
+      << (saved < 0 ? ", grew: " : ", saved: ") << (saved < 0 ? -saved : saved) << ")\n";
+  return out;
+}
+
+}// namespace lefticus::tools
+
+#endif// LEFTICUS_TOOLS_STACKIFY_FOOTPRINT_HPP
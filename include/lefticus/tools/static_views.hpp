@@ -29,14 +29,28 @@ For more information, please refer to <https://unlicense.org>
 #ifndef LEFTICUS_TOOLS_STATIC_VIEWS_HPP
 #define LEFTICUS_TOOLS_STATIC_VIEWS_HPP
 
+#include "eytzinger.hpp"
 #include "simple_stack_flat_map.hpp"
 #include "simple_stack_string.hpp"
 #include "simple_stack_vector.hpp"
 #include "utility.hpp"
 #include <algorithm>
 #include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
 #include <span>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
 
 namespace lefticus::tools {
 
@@ -114,6 +128,440 @@ consteval auto to_span(creates_iterable auto callable)
   return result;
 }
 
+// number of values `callable` produces
+consteval std::size_t iterable_size(creates_iterable auto callable)
+{
+  const auto values = callable();
+  return static_cast<std::size_t>(std::distance(values.begin(), values.end()));
+}
+
+// sorts the values by `proj` and emits them in Eytzinger (BFS) order,
+// ready for `eytzinger_lower_bound` / `eytzinger_find`. `proj` must be stateless.
+// Sized by a first call to `callable`, so it is not capped at oversized_size.
+template<typename Projection = std::identity>
+consteval auto to_eytzinger_array(creates_iterable auto callable, Projection proj = {})
+{
+  using Value_Type = typename std::decay_t<decltype(callable())>::value_type;
+  std::array<Value_Type, iterable_size(callable)> sorted{};
+  const auto values = callable();
+  std::copy(values.begin(), values.end(), sorted.begin());
+  std::ranges::sort(sorted, std::ranges::less{}, proj);
+
+  decltype(sorted) result{};
+  to_eytzinger(sorted.begin(), sorted.end(), result.begin());
+  return result;
+}
+
+template<typename Projection = std::identity>
+consteval auto to_eytzinger_span(creates_iterable auto callable, Projection proj = {})
+{
+  constexpr auto &static_data = make_static<to_eytzinger_array(callable, proj)>;
+  using Value_Type = typename std::decay_t<decltype(static_data)>::value_type;
+  std::span<const Value_Type> result(static_data.begin(), static_data.end());
+  return result;
+}
+
+
+// A compact reference into a string_table blob
+struct string_handle
+{
+  std::uint32_t offset{};
+  std::uint32_t length{};
+
+  [[nodiscard]] constexpr bool operator==(const string_handle &) const noexcept = default;
+};
+
+static_assert(sizeof(string_handle) <= 8);
+
+// All of the strings from a `to_string_table` call, stored once each in a
+// single blob. Duplicates, and strings that are a suffix of another string,
+// share storage.
+template<std::size_t BlobSize, std::size_t Count> struct string_table
+{
+  std::array<char, BlobSize> blob{};
+
+  // handles[i] refers to the i'th input string
+  std::array<string_handle, Count> handles{};
+
+  [[nodiscard]] constexpr std::string_view operator[](const string_handle handle) const noexcept
+  {
+    return std::string_view{ blob.data() + handle.offset, handle.length };
+  }
+
+  [[nodiscard]] constexpr std::string_view at(const std::size_t index) const { return (*this)[handles.at(index)]; }
+
+  [[nodiscard]] static constexpr std::size_t size() noexcept { return Count; }
+};
+
+// string_table with the sizes erased, as returned by `to_string_table_view`
+struct string_table_view
+{
+  std::string_view blob;
+  std::span<const string_handle> handles;
+
+  [[nodiscard]] constexpr std::string_view operator[](const string_handle handle) const noexcept
+  {
+    return blob.substr(handle.offset, handle.length);
+  }
+
+  [[nodiscard]] constexpr std::string_view at(const std::size_t index) const
+  {
+    if (index >= handles.size()) { throw std::out_of_range("index past end of string_table"); }
+    return (*this)[handles[index]];
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return handles.size(); }
+};
+
+namespace detail {
+  struct interned_strings
+  {
+    std::string blob;
+    std::vector<string_handle> handles;
+  };
+
+  constexpr auto to_handle_value(const std::size_t value)
+  {
+    if (value > std::numeric_limits<std::uint32_t>::max()) { throw std::length_error("string_table is too large"); }
+    return static_cast<std::uint32_t>(value);
+  }
+
+  constexpr interned_strings intern_strings(const auto &strings)
+  {
+    std::vector<std::string_view> views;
+    for (const auto &string : strings) { views.emplace_back(string.begin(), string.end()); }
+
+    // ordered by the reversed strings, largest first, so that every string
+    // comes right after the strings it is a suffix of
+    std::vector<std::size_t> order(views.size());
+    for (std::size_t index = 0; index < order.size(); ++index) { order[index] = index; }
+    std::sort(order.begin(), order.end(), [&](const std::size_t lhs, const std::size_t rhs) {
+      return std::lexicographical_compare(
+        views[rhs].rbegin(), views[rhs].rend(), views[lhs].rbegin(), views[lhs].rend());
+    });
+
+    interned_strings result;
+    result.handles.resize(views.size());
+
+    std::string_view last_emitted;
+    std::size_t last_offset = 0;
+    bool emitted_any = false;
+
+    for (const auto index : order) {
+      const auto view = views[index];
+
+      if (!emitted_any || !last_emitted.ends_with(view)) {
+        last_offset = result.blob.size();
+        last_emitted = view;
+        emitted_any = true;
+        result.blob.append(view);
+      }
+
+      result.handles[index] = string_handle{ to_handle_value(last_offset + last_emitted.size() - view.size()),
+        to_handle_value(view.size()) };
+    }
+
+    return result;
+  }
+
+  constexpr auto interned_sizes(const auto &strings)
+  {
+    const auto interned = intern_strings(strings);
+    return pair{ interned.blob.size(), interned.handles.size() };
+  }
+}// namespace detail
+
+// Merges all of the strings produced by `callable` into a single
+// right-sized blob, with an 8 byte handle per input string.
+consteval auto to_string_table(creates_iterable auto callable)
+{
+  constexpr auto sizes = detail::interned_sizes(callable());
+
+  const auto interned = detail::intern_strings(callable());
+  string_table<sizes.first, sizes.second> result;
+  std::copy(interned.blob.begin(), interned.blob.end(), result.blob.begin());
+  std::copy(interned.handles.begin(), interned.handles.end(), result.handles.begin());
+  return result;
+}
+
+consteval auto to_string_table_view(creates_iterable auto callable)
+{
+  constexpr auto &static_data = make_static<to_string_table(callable)>;
+  return string_table_view{ std::string_view{ static_data.blob.data(), static_data.blob.size() },
+    std::span<const string_handle>{ static_data.handles } };
+}
+
+// The keys of a `make_lut` table: every value of Key from First to Last,
+// inclusive. Key is an integral type, or wraps one like int_np does.
+template<typename Key, auto First, auto Last> struct lut_range
+{
+};
+
+// `Samples` evenly spaced points from Min to Max, inclusive, of a floating
+// point domain. Lookups between samples are linearly interpolated.
+template<auto Min, auto Max, std::size_t Samples> struct lut_interval
+{
+  static_assert(std::is_floating_point_v<decltype(Min)> && std::is_same_v<decltype(Min), decltype(Max)>);
+  static_assert(Min < Max && Samples >= 2);
+
+  using key_type = decltype(Min);
+  static constexpr key_type min = Min;
+  static constexpr key_type max = Max;
+  static constexpr std::size_t samples = Samples;
+};
+
+namespace detail {
+  template<typename Key>
+  concept wrapped_integral = requires(const Key &key) {
+    requires std::integral<typename Key::value_type>;
+    { key.get() } -> std::same_as<typename Key::value_type>;
+  };
+
+  template<typename Key> struct lut_underlying
+  {
+    using type = Key;
+  };
+  template<wrapped_integral Key> struct lut_underlying<Key>
+  {
+    using type = typename Key::value_type;
+  };
+
+  template<typename Domain> struct lut_domain
+  {
+    using key_type = Domain;
+    using underlying = typename lut_underlying<Domain>::type;
+    static constexpr underlying first = std::numeric_limits<underlying>::min();
+    static constexpr underlying last = std::numeric_limits<underlying>::max();
+  };
+  template<typename Key, auto First, auto Last> struct lut_domain<lut_range<Key, First, Last>>
+  {
+    using key_type = Key;
+    using underlying = typename lut_underlying<Key>::type;
+    static constexpr underlying first = First;
+    static constexpr underlying last = Last;
+    static_assert(first <= last);
+  };
+
+  template<typename Key> [[nodiscard]] constexpr auto lut_raw(const Key &key) noexcept
+  {
+    if constexpr (wrapped_integral<Key>) {
+      return key.get();
+    } else {
+      return key;
+    }
+  }
+
+  // key - first, in the key's own width so that signed domains cannot overflow
+  template<typename Underlying>
+  [[nodiscard]] constexpr std::size_t lut_offset(const Underlying key, const Underlying first) noexcept
+  {
+    using unsigned_type = std::make_unsigned_t<Underlying>;
+    return static_cast<unsigned_type>(static_cast<unsigned_type>(key) - static_cast<unsigned_type>(first));
+  }
+
+  template<auto Function, typename Domain> consteval auto lut_values()
+  {
+    using domain = lut_domain<Domain>;
+    constexpr auto size = lut_offset(domain::last, domain::first) + std::size_t{ 1 };
+    static_assert(size <= std::size_t{ 1 } << 20U, "lookup table domain is too large");
+
+    using key_type = typename domain::key_type;
+    using underlying = typename domain::underlying;
+    std::array<std::decay_t<decltype(std::invoke(Function, std::declval<key_type>()))>, size> result{};
+    for (std::size_t index = 0; index < size; ++index) {
+      const auto raw = static_cast<underlying>(static_cast<std::make_unsigned_t<underlying>>(
+        static_cast<std::make_unsigned_t<underlying>>(domain::first) + index));
+      result[index] = std::invoke(Function, key_type{ raw });
+    }
+    return result;
+  }
+
+  template<auto Function, typename Interval> consteval auto lut_samples()
+  {
+    using key_type = typename Interval::key_type;
+    constexpr auto samples = Interval::samples;
+    std::array<std::decay_t<decltype(std::invoke(Function, Interval::min))>, samples> result{};
+    for (std::size_t index = 0; index < samples; ++index) {
+      const auto position =
+        Interval::min
+        + (Interval::max - Interval::min) * static_cast<key_type>(index) / static_cast<key_type>(samples - 1);
+      result[index] = std::invoke(Function, index == samples - 1 ? Interval::max : position);
+    }
+    return result;
+  }
+
+  template<typename Domain> inline constexpr bool is_lut_interval = false;
+  template<auto Min, auto Max, std::size_t Samples>
+  inline constexpr bool is_lut_interval<lut_interval<Min, Max, Samples>> = true;
+}// namespace detail
+
+// A `make_lut` table over an integral domain, indexed by key
+template<typename Key, typename Value> class lookup_table
+{
+  using underlying = typename detail::lut_underlying<Key>::type;
+
+public:
+  using key_type = Key;
+  using value_type = Value;
+
+  constexpr lookup_table(const std::span<const Value> values_, const underlying first_) noexcept
+    : values{ values_ }, first{ first_ }
+  {}
+
+  // `key` must be in the domain
+  [[nodiscard]] constexpr const Value &operator[](const Key &key) const noexcept
+  {
+    return values[detail::lut_offset(detail::lut_raw(key), first)];
+  }
+
+  [[nodiscard]] constexpr const Value &at(const Key &key) const
+  {
+    const auto offset = detail::lut_offset(detail::lut_raw(key), first);
+    if (offset >= values.size()) { throw std::out_of_range("key outside of lookup table domain"); }
+    return values[offset];
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return values.size(); }
+  [[nodiscard]] constexpr auto begin() const noexcept { return values.begin(); }
+  [[nodiscard]] constexpr auto end() const noexcept { return values.end(); }
+  [[nodiscard]] constexpr std::span<const Value> span() const noexcept { return values; }
+
+private:
+  std::span<const Value> values;
+  underlying first;
+};
+
+// A `make_lut` table over a floating point interval, sampled evenly
+template<typename Key, typename Value> class interpolated_table
+{
+public:
+  using key_type = Key;
+  using value_type = Value;
+
+  constexpr interpolated_table(const std::span<const Value> samples_, const Key min_, const Key max_) noexcept
+    : samples{ samples_ }, min{ min_ }, max{ max_ },
+      scale{ static_cast<Key>(samples_.size() - 1) / (max_ - min_) }
+  {}
+
+  // linearly interpolated between the nearest samples, clamped to the interval
+  [[nodiscard]] constexpr Value operator()(const Key key) const noexcept
+  {
+    const auto position = (std::clamp(key, min, max) - min) * scale;
+    const auto index = std::min(static_cast<std::size_t>(position), samples.size() - 2);
+    const auto fraction = position - static_cast<Key>(index);
+    return samples[index] + (samples[index + 1] - samples[index]) * fraction;
+  }
+
+  [[nodiscard]] constexpr std::span<const Value> span() const noexcept { return samples; }
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return samples.size(); }
+
+private:
+  std::span<const Value> samples;
+  Key min;
+  Key max;
+  Key scale;
+};
+
+// Evaluates `Function` over every key of `Domain` at compile time, into a
+// static table. `Domain` is an integral or int_np type, for all of its values,
+// a `lut_range`, or a `lut_interval` for an interpolated floating point table.
+//
+//   constexpr auto reversed = make_lut<reverse_bits, std::uint8_t>();
+//   reversed[0x01] == 0x80
+template<auto Function, typename Domain> consteval auto make_lut()
+{
+  if constexpr (detail::is_lut_interval<Domain>) {
+    constexpr auto &static_data = make_static<detail::lut_samples<Function, Domain>()>;
+    using Value_Type = typename std::decay_t<decltype(static_data)>::value_type;
+    return interpolated_table<typename Domain::key_type, Value_Type>{ std::span<const Value_Type>{ static_data },
+      Domain::min,
+      Domain::max };
+  } else {
+    constexpr auto &static_data = make_static<detail::lut_values<Function, Domain>()>;
+    using Value_Type = typename std::decay_t<decltype(static_data)>::value_type;
+    using domain = detail::lut_domain<Domain>;
+    return lookup_table<typename domain::key_type, Value_Type>{ std::span<const Value_Type>{ static_data },
+      domain::first };
+  }
+}
+
+
+// Aggregate class templates whose members are exactly their template
+// parameters, in order, such as `pair<First, Second>`. These can be
+// rebuilt with the stackified / resized member types.
+namespace detail {
+  struct any_initializer
+  {
+    template<typename Type> operator Type() const;// NOLINT (implicit conversion intended)
+  };
+}// namespace detail
+
+template<typename Value, typename... Member>
+concept aggregate_of = std::is_aggregate_v<Value> && requires(const Member &...member) {
+  Value{ member... };
+} && !requires(const Member &...member) { Value{ member..., detail::any_initializer{} }; };
+
+// the largest aggregate we know how to take apart
+static constexpr std::size_t max_aggregate_members = 8;
+
+template<std::size_t Count> constexpr auto tie_members(const auto &value)
+{
+  static_assert(Count > 0 && Count <= max_aggregate_members, "unsupported number of aggregate members");
+
+  if constexpr (Count == 1) {
+    const auto &[m0] = value;
+    return std::tie(m0);
+  } else if constexpr (Count == 2) {
+    const auto &[m0, m1] = value;
+    return std::tie(m0, m1);
+  } else if constexpr (Count == 3) {
+    const auto &[m0, m1, m2] = value;
+    return std::tie(m0, m1, m2);
+  } else if constexpr (Count == 4) {
+    const auto &[m0, m1, m2, m3] = value;
+    return std::tie(m0, m1, m2, m3);
+  } else if constexpr (Count == 5) {
+    const auto &[m0, m1, m2, m3, m4] = value;
+    return std::tie(m0, m1, m2, m3, m4);
+  } else if constexpr (Count == 6) {
+    const auto &[m0, m1, m2, m3, m4, m5] = value;
+    return std::tie(m0, m1, m2, m3, m4, m5);
+  } else if constexpr (Count == 7) {
+    const auto &[m0, m1, m2, m3, m4, m5, m6] = value;
+    return std::tie(m0, m1, m2, m3, m4, m5, m6);
+  } else {
+    const auto &[m0, m1, m2, m3, m4, m5, m6, m7] = value;
+    return std::tie(m0, m1, m2, m3, m4, m5, m6, m7);
+  }
+}
+
+
+// All of the overloads are declared up front, because they call each other
+// recursively and most of the types involved live in `std`, so ADL will
+// not find the ones declared later.
+template<std::size_t MaxSize> constexpr auto stackify(auto value);
+template<std::size_t MaxSize, typename CharType, std::size_t CurSize>
+constexpr auto stackify(const basic_simple_stack_string<CharType, CurSize> &string);
+template<std::size_t MaxSize, typename CharType> constexpr auto stackify(const std::basic_string<CharType> &string);
+template<std::size_t MaxSize, typename Value> constexpr auto stackify(const std::vector<Value> &vec);
+template<std::size_t MaxSize, typename Value, std::size_t CurSize>
+constexpr auto stackify(const simple_stack_vector<Value, CurSize> &vec);
+template<std::size_t MaxSize, typename Key, typename Value, typename Container>
+constexpr auto stackify(const flat_map_adapter<Key, Value, Container> &map);
+template<std::size_t MaxSize, typename Key, typename Value, typename Compare, typename Allocator>
+constexpr auto stackify(const std::map<Key, Value, Compare, Allocator> &map);
+template<std::size_t MaxSize, typename Value> constexpr auto stackify(const std::optional<Value> &value);
+template<std::size_t MaxSize, typename Value, std::size_t Size>
+constexpr auto stackify(const std::array<Value, Size> &values);
+template<std::size_t MaxSize, typename... Value> constexpr auto stackify(const std::tuple<Value...> &values);
+template<std::size_t MaxSize, typename... Value> constexpr auto stackify(const std::variant<Value...> &value);
+template<std::size_t MaxSize, template<typename...> typename Aggregate, typename... Member>
+  requires aggregate_of<Aggregate<Member...>, Member...>
+constexpr auto stackify(const Aggregate<Member...> &value);
+
+template<std::size_t MaxSize, typename Value>
+using stackified_t = decltype(stackify<MaxSize>(std::declval<const Value &>()));
+
 
 template<std::size_t MaxSize> constexpr auto stackify(auto value) { return value; }
 
@@ -132,41 +580,153 @@ template<std::size_t MaxSize, typename CharType> constexpr auto stackify(const s
 
 template<std::size_t MaxSize, typename Value> constexpr auto stackify(const std::vector<Value> &vec)
 {
-  return simple_stack_vector<decltype(stackify<MaxSize>(std::declval<Value>())), MaxSize>{ vec.begin(), vec.end() };
+  simple_stack_vector<stackified_t<MaxSize, Value>, MaxSize> result;
+  for (const auto &value : vec) { result.push_back(stackify<MaxSize>(value)); }
+  return result;
 }
 
 template<std::size_t MaxSize, typename Value, std::size_t CurSize>
 constexpr auto stackify(const simple_stack_vector<Value, CurSize> &vec)
 {
-  return simple_stack_vector<decltype(stackify<MaxSize>(std::declval<Value>())), CurSize>{ vec.begin(), vec.end() };
+  simple_stack_vector<stackified_t<MaxSize, Value>, CurSize> result;
+  for (const auto &value : vec) { result.push_back(stackify<MaxSize>(value)); }
+  return result;
 }
 
 
 template<std::size_t MaxSize, typename Key, typename Value, typename Container>
 constexpr auto stackify(const flat_map_adapter<Key, Value, Container> &map)
 {
-  return simple_stack_flat_map<decltype(stackify<MaxSize>(std::declval<Key>())),
-    decltype(stackify<MaxSize>(std::declval<Value>())),
-    MaxSize>{ map.begin(), map.end() };
+  simple_stack_flat_map<stackified_t<MaxSize, Key>, stackified_t<MaxSize, Value>, MaxSize> result;
+  using value_type = typename decltype(result)::value_type;
+  for (const auto &[key, value] : map) {
+    result.data.push_back(value_type{ stackify<MaxSize>(key), stackify<MaxSize>(value) });
+  }
+  return result;
 }
 
 template<std::size_t MaxSize, typename Key, typename Value, std::size_t CurSize>
 constexpr auto stackify(const simple_stack_flat_map<Key, Value, CurSize> &map)
 {
-  return simple_stack_flat_map<decltype(stackify<MaxSize>(std::declval<Key>())),
-    decltype(stackify<MaxSize>(std::declval<Value>())),
-    CurSize>{ map.begin(), map.end() };
+  simple_stack_flat_map<stackified_t<MaxSize, Key>, stackified_t<MaxSize, Value>, CurSize> result;
+  using value_type = typename decltype(result)::value_type;
+  for (const auto &[key, value] : map) {
+    result.data.push_back(value_type{ stackify<MaxSize>(key), stackify<MaxSize>(value) });
+  }
+  return result;
+}
+
+// std::map is not usable in a constant expression, but it can still be
+// stackified at runtime
+template<std::size_t MaxSize, typename Key, typename Value, typename Compare, typename Allocator>
+constexpr auto stackify(const std::map<Key, Value, Compare, Allocator> &map)
+{
+  simple_stack_flat_map<stackified_t<MaxSize, Key>, stackified_t<MaxSize, Value>, MaxSize> result;
+  using value_type = typename decltype(result)::value_type;
+  for (const auto &[key, value] : map) {
+    result.data.push_back(value_type{ stackify<MaxSize>(key), stackify<MaxSize>(value) });
+  }
+  return result;
+}
+
+template<std::size_t MaxSize, typename Value> constexpr auto stackify(const std::optional<Value> &value)
+{
+  std::optional<stackified_t<MaxSize, Value>> result;
+  if (value) { result = stackify<MaxSize>(*value); }
+  return result;
+}
+
+template<std::size_t MaxSize, typename Value, std::size_t Size>
+constexpr auto stackify(const std::array<Value, Size> &values)
+{
+  std::array<stackified_t<MaxSize, Value>, Size> result{};
+  std::transform(values.begin(), values.end(), result.begin(), [](const auto &value) {
+    return stackify<MaxSize>(value);
+  });
+  return result;
+}
+
+template<std::size_t MaxSize, typename... Value> constexpr auto stackify(const std::tuple<Value...> &values)
+{
+  return std::apply(
+    [](const auto &...value) { return std::tuple<stackified_t<MaxSize, Value>...>{ stackify<MaxSize>(value)... }; },
+    values);
+}
+
+template<std::size_t MaxSize, typename... Value> constexpr auto stackify(const std::variant<Value...> &value)
+{
+  return std::visit(
+    [](const auto &alternative) -> std::variant<stackified_t<MaxSize, Value>...> {
+      return stackify<MaxSize>(alternative);
+    },
+    value);
+}
+
+template<std::size_t MaxSize, template<typename...> typename Aggregate, typename... Member>
+  requires aggregate_of<Aggregate<Member...>, Member...>
+constexpr auto stackify(const Aggregate<Member...> &value)
+{
+  return std::apply(
+    [](const auto &...member) {
+      return Aggregate<stackified_t<MaxSize, Member>...>{ stackify<MaxSize>(member)... };
+    },
+    tie_members<sizeof...(Member)>(value));
+}
+
+
+// The sizes of each member of a tuple-like value are stored as a chain of
+// `pair{ size, pair{ size, ... end_of_sizes } }` so they remain usable as a
+// template parameter.
+struct end_of_sizes
+{
+};
+
+constexpr auto make_sizes() { return end_of_sizes{}; }
+
+constexpr auto make_sizes(const auto &first, const auto &...rest) { return pair{ first, make_sizes(rest...) }; }
+
+template<std::size_t Index> constexpr auto get_size(const auto &sizes)
+{
+  if constexpr (Index == 0) {
+    return sizes.first;
+  } else {
+    return get_size<Index - 1>(sizes.second);
+  }
 }
 
 
 template<typename Arg> constexpr auto max_max(const Arg &lhs, const Arg &rhs) { return std::max(lhs, rhs); }
 
+template<typename First, typename Second>
+constexpr auto max_max(const pair<First, Second> &lhs, const pair<First, Second> &rhs);
+
+constexpr auto max_max(end_of_sizes, end_of_sizes) { return end_of_sizes{}; }
+
 template<typename First, typename Second>
 constexpr auto max_max(const pair<First, Second> &lhs, const pair<First, Second> &rhs)
 {
   return pair{ max_max(lhs.first, rhs.first), max_max(lhs.second, rhs.second) };
 }
 
+
+constexpr auto max_element_size([[maybe_unused]] auto value);
+template<typename CharType, std::size_t CurSize>
+constexpr auto max_element_size(const basic_simple_stack_string<CharType, CurSize> &string);
+template<typename Value, std::size_t CurSize>
+constexpr auto max_element_size(const simple_stack_vector<Value, CurSize> &vec);
+template<typename Key, typename Value, std::size_t CurSize>
+constexpr auto max_element_size(const simple_stack_flat_map<Key, Value, CurSize> &map);
+template<typename Value> constexpr auto max_element_size(const std::optional<Value> &value);
+template<typename Value, std::size_t Size> constexpr auto max_element_size(const std::array<Value, Size> &values);
+template<typename... Value> constexpr auto max_element_size(const std::tuple<Value...> &values);
+template<typename... Value> constexpr auto max_element_size(const std::variant<Value...> &value);
+template<template<typename...> typename Aggregate, typename... Member>
+  requires aggregate_of<Aggregate<Member...>, Member...>
+constexpr auto max_element_size(const Aggregate<Member...> &value);
+
+template<typename Value> using element_size_t = decltype(max_element_size(std::declval<const Value &>()));
+
+
 constexpr auto max_element_size([[maybe_unused]] auto value) { return 1; }
 
 template<typename CharType, std::size_t CurSize>
@@ -178,7 +738,7 @@ constexpr auto max_element_size(const basic_simple_stack_string<CharType, CurSiz
 template<typename Value, std::size_t CurSize>
 constexpr auto max_element_size(const simple_stack_vector<Value, CurSize> &vec)
 {
-  decltype(max_element_size(std::declval<Value>())) child_max{};
+  element_size_t<Value> child_max{};
 
   for (const auto &elem : vec) { child_max = max_max(child_max, max_element_size(elem)); }
   return pair{ vec.size(), child_max };
@@ -187,8 +747,8 @@ constexpr auto max_element_size(const simple_stack_vector<Value, CurSize> &vec)
 template<typename Key, typename Value, std::size_t CurSize>
 constexpr auto max_element_size(const simple_stack_flat_map<Key, Value, CurSize> &map)
 {
-  decltype(max_element_size(std::declval<Key>())) key_max{};
-  decltype(max_element_size(std::declval<Value>())) value_max{};
+  element_size_t<Key> key_max{};
+  element_size_t<Value> value_max{};
 
   for (const auto &elem : map) {
     key_max = max_max(key_max, max_element_size(elem.first));
@@ -198,6 +758,64 @@ constexpr auto max_element_size(const simple_stack_flat_map<Key, Value, CurSize>
   return pair{ map.size(), pair{ key_max, value_max } };
 }
 
+template<typename Value> constexpr auto max_element_size(const std::optional<Value> &value)
+{
+  if (value) { return max_element_size(*value); }
+  return element_size_t<Value>{};
+}
+
+// a std::array's own size is fixed, so only its elements can shrink
+template<typename Value, std::size_t Size> constexpr auto max_element_size(const std::array<Value, Size> &values)
+{
+  element_size_t<Value> child_max{};
+
+  for (const auto &elem : values) { child_max = max_max(child_max, max_element_size(elem)); }
+  return child_max;
+}
+
+template<typename... Value> constexpr auto max_element_size(const std::tuple<Value...> &values)
+{
+  return std::apply([](const auto &...value) { return make_sizes(max_element_size(value)...); }, values);
+}
+
+// only the active alternative has a size, the others stay at their minimum
+template<typename... Value> constexpr auto max_element_size(const std::variant<Value...> &value)
+{
+  return [&]<std::size_t... Index>(std::index_sequence<Index...>)
+  {
+    return make_sizes(
+      (value.index() == Index ? max_element_size(std::get<Index>(value)) : element_size_t<Value>{})...);
+  }
+  (std::index_sequence_for<Value...>{});
+}
+
+template<template<typename...> typename Aggregate, typename... Member>
+  requires aggregate_of<Aggregate<Member...>, Member...>
+constexpr auto max_element_size(const Aggregate<Member...> &value)
+{
+  return std::apply([](const auto &...member) { return make_sizes(max_element_size(member)...); },
+    tie_members<sizeof...(Member)>(value));
+}
+
+
+template<auto NewSize> constexpr auto resize(const auto &value);
+template<auto NewSize, typename CharType, std::size_t CurSize>
+constexpr auto resize(const basic_simple_stack_string<CharType, CurSize> &str);
+template<auto NewSize, typename Value, std::size_t CurSize>
+constexpr auto resize(const simple_stack_vector<Value, CurSize> &vec);
+template<auto NewSize, typename Key, typename Value, std::size_t CurSize>
+constexpr auto resize(const simple_stack_flat_map<Key, Value, CurSize> &map);
+template<auto NewSize, typename Value> constexpr auto resize(const std::optional<Value> &value);
+template<auto NewSize, typename Value, std::size_t Size> constexpr auto resize(const std::array<Value, Size> &values);
+template<auto NewSize, typename... Value> constexpr auto resize(const std::tuple<Value...> &values);
+template<auto NewSize, typename... Value> constexpr auto resize(const std::variant<Value...> &value);
+template<auto NewSize, template<typename...> typename Aggregate, typename... Member>
+  requires aggregate_of<Aggregate<Member...>, Member...>
+constexpr auto resize(const Aggregate<Member...> &value);
+
+template<auto NewSize, typename Value> using resized_t = decltype(resize<NewSize>(std::declval<const Value &>()));
+
+
 template<auto NewSize> constexpr auto resize(const auto &value) { return value; }
 
 template<auto NewSize, typename CharType, std::size_t CurSize>
@@ -210,17 +828,75 @@ constexpr auto resize(const basic_simple_stack_string<CharType, CurSize> &str)
 template<auto NewSize, typename Value, std::size_t CurSize>
 constexpr auto resize(const simple_stack_vector<Value, CurSize> &vec)
 {
-  using new_value_type = decltype(resize<NewSize.second>(std::declval<Value>()));
-  return simple_stack_vector<new_value_type, NewSize.first>{ vec.begin(), vec.end() };
+  simple_stack_vector<resized_t<NewSize.second, Value>, NewSize.first> result;
+  for (const auto &value : vec) { result.push_back(resize<NewSize.second>(value)); }
+  return result;
 }
 
 template<auto NewSize, typename Key, typename Value, std::size_t CurSize>
 constexpr auto resize(const simple_stack_flat_map<Key, Value, CurSize> &map)
 {
-  using new_key_type = decltype(resize<NewSize.second.first>(std::declval<Key>()));
-  using new_value_type = decltype(resize<NewSize.second.second>(std::declval<Value>()));
+  using new_key_type = resized_t<NewSize.second.first, Key>;
+  using new_value_type = resized_t<NewSize.second.second, Value>;
+
+  simple_stack_flat_map<new_key_type, new_value_type, NewSize.first> result;
+  using value_type = typename decltype(result)::value_type;
+  for (const auto &[key, value] : map) {
+    result.data.push_back(value_type{ resize<NewSize.second.first>(key), resize<NewSize.second.second>(value) });
+  }
+  return result;
+}
+
+template<auto NewSize, typename Value> constexpr auto resize(const std::optional<Value> &value)
+{
+  std::optional<resized_t<NewSize, Value>> result;
+  if (value) { result = resize<NewSize>(*value); }
+  return result;
+}
+
+template<auto NewSize, typename Value, std::size_t Size> constexpr auto resize(const std::array<Value, Size> &values)
+{
+  std::array<resized_t<NewSize, Value>, Size> result{};
+  std::transform(
+    values.begin(), values.end(), result.begin(), [](const auto &value) { return resize<NewSize>(value); });
+  return result;
+}
+
+template<auto NewSize, typename... Value> constexpr auto resize(const std::tuple<Value...> &values)
+{
+  return [&]<std::size_t... Index>(std::index_sequence<Index...>)
+  {
+    return std::tuple<resized_t<get_size<Index>(NewSize), Value>...>{ resize<get_size<Index>(NewSize)>(
+      std::get<Index>(values))... };
+  }
+  (std::index_sequence_for<Value...>{});
+}
 
-  return simple_stack_flat_map<new_key_type, new_value_type, NewSize.first>{ map.begin(), map.end() };
+template<auto NewSize, typename... Value> constexpr auto resize(const std::variant<Value...> &value)
+{
+  return [&]<std::size_t... Index>(std::index_sequence<Index...>)
+  {
+    std::variant<resized_t<get_size<Index>(NewSize), Value>...> result;
+    ((value.index() == Index ? static_cast<void>(result.template emplace<Index>(
+        resize<get_size<Index>(NewSize)>(std::get<Index>(value))))
+                             : static_cast<void>(0)),
+      ...);
+    return result;
+  }
+  (std::index_sequence_for<Value...>{});
+}
+
+template<auto NewSize, template<typename...> typename Aggregate, typename... Member>
+  requires aggregate_of<Aggregate<Member...>, Member...>
+constexpr auto resize(const Aggregate<Member...> &value)
+{
+  return [&]<std::size_t... Index>(std::index_sequence<Index...>)
+  {
+    const auto members = tie_members<sizeof...(Member)>(value);
+    return Aggregate<resized_t<get_size<Index>(NewSize), Member>...>{ resize<get_size<Index>(NewSize)>(
+      std::get<Index>(members))... };
+  }
+  (std::index_sequence_for<Member...>{});
 }
 
 template<std::size_t MaxSize, typename Callable> constexpr auto minimized_stackify(Callable callable)
@@ -66,6 +66,15 @@ concept orderable = requires(LHS lhs, RHS rhs) { order(lhs, rhs); };
 template<typename LHS, typename RHS>
 concept equatable = requires(LHS lhs, RHS rhs) { equate(lhs, rhs); };
 
+template<typename Value>
+concept incrementable = requires(Value value) { increment(value); };
+
+template<typename Value>
+concept decrementable = requires(Value value) { decrement(value); };
+
+template<typename Value>
+concept validated_in_place = requires(Value value) { validate_in_place(value); };
+
 template<typename From, typename To>
 concept casts_to = requires(const From &from) {
   {
@@ -74,7 +83,19 @@ concept casts_to = requires(const From &from) {
 };
 
 
-template<typename Underlying> constexpr void null_validator(const Underlying &) {}
+template<typename Underlying> constexpr void null_validator(const Underlying &) noexcept {}
+
+#ifdef NDEBUG
+inline constexpr bool debug_validation = false;
+#else
+inline constexpr bool debug_validation = true;
+#endif
+
+// Validation policy: runs Validator only in builds without NDEBUG, the way assert does
+template<auto Validator>
+inline constexpr auto debug_only = [](const auto &value) noexcept(!debug_validation || noexcept(Validator(value))) {
+  if constexpr (debug_validation) { Validator(value); }
+};
 
 template<typename Underlying, typename Tag, auto Validator = &null_validator<Underlying>> struct strong_alias
 {
@@ -83,9 +104,16 @@ template<typename Underlying, typename Tag, auto Validator = &null_validator<Und
     requires std::is_constructible_v<Underlying, decltype(param)...>
     : data(std::forward<Param>(param)...)
   {
+    // a strong_alias must be usable anywhere its Underlying is, including memcpy and vectorised loops
+    static_assert(sizeof(strong_alias) == sizeof(Underlying));
+    static_assert(std::is_trivially_copyable_v<strong_alias> == std::is_trivially_copyable_v<Underlying>);
+    static_assert(std::is_standard_layout_v<strong_alias> == std::is_standard_layout_v<Underlying>);
     Validator(data);
   }
 
+  // re-checks the invariant after in-place modification
+  constexpr void validate() const noexcept(noexcept(Validator(std::declval<const Underlying &>()))) { Validator(data); }
+
   [[nodiscard]] constexpr const Underlying &get() const & noexcept { return data; }
   [[nodiscard]] constexpr Underlying &&get() && noexcept { return std::move(data); }
   [[nodiscard]] constexpr Underlying &get() & noexcept { return data; }
@@ -98,6 +126,29 @@ template<typename Underlying, typename Tag, auto Validator = &null_validator<Und
     requires(equatable<strong_alias, strong_alias>)
   = default;
 
+  // Spelled out so that `a < b` compiles to the same single compare as on the
+  // underlying type; the rewritten `(a <=> b) < 0` form does not for floating point
+  [[nodiscard]] constexpr bool operator<(const strong_alias &rhs) const noexcept
+    requires(orderable<strong_alias, strong_alias>)
+  {
+    return data < rhs.data;
+  }
+  [[nodiscard]] constexpr bool operator>(const strong_alias &rhs) const noexcept
+    requires(orderable<strong_alias, strong_alias>)
+  {
+    return data > rhs.data;
+  }
+  [[nodiscard]] constexpr bool operator<=(const strong_alias &rhs) const noexcept
+    requires(orderable<strong_alias, strong_alias>)
+  {
+    return data <= rhs.data;
+  }
+  [[nodiscard]] constexpr bool operator>=(const strong_alias &rhs) const noexcept
+    requires(orderable<strong_alias, strong_alias>)
+  {
+    return data >= rhs.data;
+  }
+
   template<typename U2, typename T2>
   [[nodiscard]] constexpr auto operator<=>(const strong_alias<U2, T2> &rhs) const noexcept
     requires(orderable<strong_alias, strong_alias<U2, T2>>)
@@ -115,11 +166,11 @@ private:
   Underlying data;
 };
 
-template<typename LHS, typename RHS>
+template<typename LHS>
 [[nodiscard]] constexpr auto operator-(LHS &&lhs) noexcept(noexcept(-lhs.get())) -> decltype(negate(lhs))
   requires(negatable<LHS>)
 {
-  return decltype(negate(lhs)){ std::forward<LHS>(lhs).get() };
+  return decltype(negate(lhs)){ -std::forward<LHS>(lhs).get() };
 }
 
 template<typename LHS, typename RHS>
@@ -154,6 +205,95 @@ template<typename LHS, typename RHS>
   return decltype(divide(lhs, rhs)){ std::forward<LHS>(lhs).get() / std::forward<RHS>(rhs).get() };
 }
 
+// In-place versions of the above, available when the binary operation yields the type of the left hand side.
+// They modify the underlying value directly, so no temporary strong_alias is constructed, and re-run the
+// Validator only where debug_validation is set. Declare `auto validate_in_place(T) -> void;` to always re-run it.
+template<typename Value>
+constexpr void revalidate(const Value &value) noexcept(
+  !(debug_validation || validated_in_place<Value>) || noexcept(value.validate()))
+{
+  if constexpr (debug_validation || validated_in_place<Value>) { value.validate(); }
+}
+
+template<typename LHS, typename RHS>
+constexpr LHS &operator+=(LHS &lhs, RHS &&rhs) noexcept(noexcept(lhs.get() += rhs.get()) && noexcept(revalidate(lhs)))
+  requires(addable<LHS, RHS> && std::same_as<decltype(add(lhs, rhs)), LHS>
+           && requires { lhs.get() += std::forward<RHS>(rhs).get(); })
+{
+  lhs.get() += std::forward<RHS>(rhs).get();
+  revalidate(lhs);
+  return lhs;
+}
+
+template<typename LHS, typename RHS>
+constexpr LHS &operator-=(LHS &lhs, RHS &&rhs) noexcept(noexcept(lhs.get() -= rhs.get()) && noexcept(revalidate(lhs)))
+  requires(subtractable<LHS, RHS> && std::same_as<decltype(subtract(lhs, rhs)), LHS>
+           && requires { lhs.get() -= std::forward<RHS>(rhs).get(); })
+{
+  lhs.get() -= std::forward<RHS>(rhs).get();
+  revalidate(lhs);
+  return lhs;
+}
+
+template<typename LHS, typename RHS>
+constexpr LHS &operator*=(LHS &lhs, RHS &&rhs) noexcept(noexcept(lhs.get() *= rhs.get()) && noexcept(revalidate(lhs)))
+  requires(multipliable<LHS, RHS> && std::same_as<decltype(multiply(lhs, rhs)), LHS>
+           && requires { lhs.get() *= std::forward<RHS>(rhs).get(); })
+{
+  lhs.get() *= std::forward<RHS>(rhs).get();
+  revalidate(lhs);
+  return lhs;
+}
+
+template<typename LHS, typename RHS>
+constexpr LHS &operator/=(LHS &lhs, RHS &&rhs) noexcept(noexcept(lhs.get() /= rhs.get()) && noexcept(revalidate(lhs)))
+  requires(dividable<LHS, RHS> && std::same_as<decltype(divide(lhs, rhs)), LHS>
+           && requires { lhs.get() /= std::forward<RHS>(rhs).get(); })
+{
+  lhs.get() /= std::forward<RHS>(rhs).get();
+  revalidate(lhs);
+  return lhs;
+}
+
+// ++ and -- are opt-in, declare `auto increment(T) -> T;` and `auto decrement(T) -> T;`
+template<typename Value>
+constexpr Value &operator++(Value &value) noexcept(noexcept(++value.get()) && noexcept(revalidate(value)))
+  requires(incrementable<Value> && std::same_as<decltype(increment(value)), Value>)
+{
+  ++value.get();
+  revalidate(value);
+  return value;
+}
+
+template<typename Value>
+[[nodiscard]] constexpr Value operator++(Value &value,
+  int) noexcept(noexcept(++value) && std::is_nothrow_copy_constructible_v<Value>)
+  requires(incrementable<Value> && std::same_as<decltype(increment(value)), Value>)
+{
+  auto result = value;
+  ++value;
+  return result;
+}
+
+template<typename Value>
+constexpr Value &operator--(Value &value) noexcept(noexcept(--value.get()) && noexcept(revalidate(value)))
+  requires(decrementable<Value> && std::same_as<decltype(decrement(value)), Value>)
+{
+  --value.get();
+  revalidate(value);
+  return value;
+}
+
+template<typename Value>
+[[nodiscard]] constexpr Value operator--(Value &value,
+  int) noexcept(noexcept(--value) && std::is_nothrow_copy_constructible_v<Value>)
+  requires(decrementable<Value> && std::same_as<decltype(decrement(value)), Value>)
+{
+  auto result = value;
+  --value;
+  return result;
+}
+
 template<typename To, typename From>
 [[nodiscard]] constexpr auto strong_cast(From &&from) -> To
   requires(casts_to<From, To>)
@@ -0,0 +1,177 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_STRONG_VECTOR_HPP
+#define LEFTICUS_TOOLS_STRONG_VECTOR_HPP
+
+#include "simple_stack_vector.hpp"
+#include "strong_types.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace lefticus::tools {
+
+template<typename Tag> using strong_index = strong_alias<std::uint32_t, Tag>;
+
+template<typename Index>
+concept strong_index_type = requires(const Index &index) {
+  {
+    index.get()
+  } -> std::convertible_to<std::size_t>;
+} && std::unsigned_integral<std::remove_cvref_t<decltype(std::declval<const Index &>().get())>>;
+
+// A sequence container that can only be indexed by Index, so a position into
+// one strong_vector cannot be used with another. operator[] is unchecked like
+// std::vector's, apart from builds without NDEBUG; at() always checks.
+template<strong_index_type Index, typename Value, typename Container = std::vector<Value>> struct strong_vector
+{
+  using index_type = Index;
+  using container_type = Container;
+  using value_type = typename Container::value_type;
+  using size_type = typename Container::size_type;
+  using difference_type = typename Container::difference_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename Container::iterator;
+  using const_iterator = typename Container::const_iterator;
+
+  using index_underlying_type = std::remove_cvref_t<decltype(std::declval<const Index &>().get())>;
+
+  constexpr strong_vector() = default;
+  constexpr explicit strong_vector(Container container) : data(std::move(container)) {}
+  constexpr explicit strong_vector(std::initializer_list<value_type> values) : data(values) {}
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return data.size() == 0; }
+  [[nodiscard]] constexpr size_type size() const noexcept { return data.size(); }
+  [[nodiscard]] constexpr size_type max_size() const noexcept
+  {
+    return std::min<size_type>(data.max_size(), std::numeric_limits<index_underlying_type>::max());
+  }
+
+  [[nodiscard]] constexpr iterator begin() noexcept { return data.begin(); }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return data.begin(); }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return data.cbegin(); }
+  [[nodiscard]] constexpr iterator end() noexcept { return data.end(); }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return data.end(); }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return data.cend(); }
+
+  [[nodiscard]] constexpr reference front() noexcept { return data.front(); }
+  [[nodiscard]] constexpr const_reference front() const noexcept { return data.front(); }
+  [[nodiscard]] constexpr reference back() noexcept { return data.back(); }
+  [[nodiscard]] constexpr const_reference back() const noexcept { return data.back(); }
+
+  [[nodiscard]] constexpr bool contains(const Index index) const noexcept { return index.get() < data.size(); }
+
+  [[nodiscard]] constexpr reference operator[](const Index index) noexcept(!debug_validation)
+  {
+    if constexpr (debug_validation) { check(index); }
+    return data[index.get()];
+  }
+
+  [[nodiscard]] constexpr const_reference operator[](const Index index) const noexcept(!debug_validation)
+  {
+    if constexpr (debug_validation) { check(index); }
+    return data[index.get()];
+  }
+
+  [[nodiscard]] constexpr reference at(const Index index)
+  {
+    check(index);
+    return data[index.get()];
+  }
+
+  [[nodiscard]] constexpr const_reference at(const Index index) const
+  {
+    check(index);
+    return data[index.get()];
+  }
+
+  // the index the next push_back / emplace_back will return
+  [[nodiscard]] constexpr Index next_index() const noexcept
+  {
+    return Index{ static_cast<index_underlying_type>(data.size()) };
+  }
+
+  template<typename... Param> constexpr Index emplace_back(Param &&...param)
+  {
+    if (data.size() >= max_size()) { throw std::length_error("strong_vector index type exhausted"); }
+    const auto index = next_index();
+    data.emplace_back(std::forward<Param>(param)...);
+    return index;
+  }
+
+  constexpr Index push_back(const value_type &value) { return emplace_back(value); }
+  constexpr Index push_back(value_type &&value) { return emplace_back(std::move(value)); }
+
+  constexpr void pop_back() { data.pop_back(); }
+  constexpr void clear() { data.clear(); }
+  constexpr void reserve(const size_type new_capacity) { data.reserve(new_capacity); }
+  constexpr void resize(const size_type new_size)
+  {
+    if (new_size > max_size()) { throw std::length_error("strong_vector index type exhausted"); }
+    data.resize(new_size);
+  }
+
+  // every valid index, in order
+  [[nodiscard]] constexpr auto indices() const noexcept
+  {
+    return std::views::iota(index_underlying_type{}, static_cast<index_underlying_type>(data.size()))
+           | std::views::transform([](const index_underlying_type index) { return Index{ index }; });
+  }
+
+  [[nodiscard]] constexpr const Container &container() const noexcept { return data; }
+
+  [[nodiscard]] constexpr bool operator==(const strong_vector &rhs) const
+    requires std::equality_comparable<value_type>
+  {
+    return data == rhs.data;
+  }
+
+private:
+  constexpr void check(const Index index) const
+  {
+    if (!contains(index)) { throw std::out_of_range("index past end of strong_vector"); }
+  }
+
+  Container data;
+};
+
+template<strong_index_type Index, typename Value, std::size_t Capacity>
+using simple_stack_strong_vector = strong_vector<Index, Value, simple_stack_vector<Value, Capacity>>;
+
+}// namespace lefticus::tools
+
+#endif// LEFTICUS_TOOLS_STRONG_VECTOR_HPP
@@ -0,0 +1,277 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_TIMER_WHEEL_HPP
+#define LEFTICUS_TOOLS_TIMER_WHEEL_HPP
+
+#include "lambda_scheduler.hpp"
+#include "simple_stack_vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace lefticus::tools::lambda_coroutines {
+
+struct timer_id
+{
+  std::uint32_t index{};
+  std::uint32_t generation{};
+
+  [[nodiscard]] constexpr bool operator==(const timer_id &) const noexcept = default;
+};
+
+// A hierarchical timing wheel of up to Capacity pending timers, counted in
+// ticks. Each of the Levels wheels has 2^SlotBits buckets, and each level's
+// bucket covers a whole turn of the level below it. Starting and cancelling a
+// timer is O(1). On every tick the due bucket of the lowest level expires as
+// one batch, and one bucket of a higher level cascades down whenever a lower
+// level wraps.
+//
+// Timers are intrusive doubly linked lists through a fixed array of nodes,
+// so nothing allocates. With many timers this is large; put it on the heap.
+//
+// A task sleeps with lambda_co_yield(timers.sleep_for(ticks)) and is woken
+// through the scheduler that advance() is given.
+template<std::size_t Capacity, std::size_t Levels = 4, std::size_t SlotBits = 6> class timer_wheel
+{
+  static_assert(Capacity < wait_queue::npos, "timer indexes must fit in 32 bits");
+  static_assert(Levels > 0 && SlotBits > 0 && SlotBits <= 6, "a level's occupancy must fit in 64 bits");
+  static_assert(Levels * SlotBits < 64);
+
+  static constexpr std::uint32_t npos = wait_queue::npos;
+  static constexpr std::size_t slot_count = std::size_t{ 1 } << SlotBits;
+  static constexpr std::size_t slot_mask = slot_count - 1;
+
+  struct node
+  {
+    std::uint64_t expires = 0;
+    wait_queue sleepers;
+    std::uint32_t next = npos;
+    std::uint32_t prev = npos;
+    // odd while the timer is pending
+    std::uint32_t generation = 0;
+    std::uint8_t level = 0;
+    std::uint8_t slot = 0;
+  };
+
+public:
+  // the longest delay that is placed directly; longer timers are parked in the
+  // top level and cascade through it again until they are in range
+  static constexpr std::uint64_t horizon = std::uint64_t{ 1 } << (Levels * SlotBits);
+
+  [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Capacity; }
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return live; }
+  [[nodiscard]] constexpr bool empty() const noexcept { return live == 0; }
+  // ticks advanced so far
+  [[nodiscard]] constexpr std::uint64_t now() const noexcept { return current; }
+
+  // starts a timer that expires `delay` ticks from now, at least one tick away
+  constexpr timer_id start(const std::uint64_t delay)
+  {
+    std::uint32_t index = free_head;
+    if (index == npos) {
+      if (nodes.size() == Capacity) { throw std::length_error("timer_wheel is full"); }
+      index = static_cast<std::uint32_t>(nodes.size());
+      nodes.emplace_back();
+    } else {
+      free_head = nodes[index].next;
+    }
+
+    auto &timer = nodes[index];
+    // saturates, so a delay of UINT64_MAX means never instead of wrapping around to now
+    const auto ticks = std::max<std::uint64_t>(delay, 1);
+    constexpr auto never = std::numeric_limits<std::uint64_t>::max();
+    timer.expires = ticks > never - current ? never : current + ticks;
+    timer.sleepers = wait_queue{};
+    ++timer.generation;
+    ++live;
+    link(index, current + 1);
+    return timer_id{ index, timer.generation };
+  }
+
+  // false once the timer has expired or been cancelled
+  [[nodiscard]] constexpr bool pending(const timer_id id) const noexcept
+  {
+    return id.index < nodes.size() && nodes[id.index].generation == id.generation && (id.generation & 1U) == 1U;
+  }
+
+  // stops a timer that no task is waiting on, returning whether it was pending
+  constexpr bool cancel(const timer_id id)
+  {
+    if (!pending(id)) { return false; }
+    auto &timer = nodes[id.index];
+    if (!timer.sleepers.empty()) { throw std::logic_error("tasks are still waiting on this timer"); }
+    unlink(id.index);
+    release(id.index);
+    return true;
+  }
+
+  // the step that suspends the calling task until the timer expires
+  [[nodiscard]] constexpr task_step wait(const timer_id id)
+  {
+    if (!pending(id)) { throw std::invalid_argument("timer is not pending"); }
+    return task_step::wait(nodes[id.index].sleepers);
+  }
+
+  [[nodiscard]] constexpr task_step sleep_for(const std::uint64_t delay) { return wait(start(delay)); }
+
+  // moves time forward by `ticks`, expiring every timer that comes due and making
+  // the tasks waiting on them ready in `tasks`. Returns how many tasks woke.
+  template<typename Scheduler> constexpr std::size_t advance(Scheduler &tasks, const std::uint64_t ticks)
+  {
+    const auto target = current + ticks;
+    std::size_t woken = 0;
+    while (current < target) {
+      if (live == 0) {
+        current = target;
+        break;
+      }
+
+      const auto next = current + 1;
+      const std::size_t index = next & slot_mask;
+      if (index != 0) {
+        // nothing cascades before the level wraps, so jump over empty buckets
+        const auto due = occupied[0] >> index;
+        const auto skip = due == 0 ? slot_count - index : static_cast<std::size_t>(std::countr_zero(due));
+        if (skip != 0) {
+          current = std::min(target, current + skip);
+          continue;
+        }
+      }
+
+      current = next;
+      if (index == 0) { cascade(); }
+      woken += expire(tasks, index);
+    }
+    return woken;
+  }
+
+private:
+  // places the timer in the level whose span covers its delay, counted from
+  // `base`, the first tick that has not been expired yet
+  constexpr void link(const std::uint32_t index, const std::uint64_t base) noexcept
+  {
+    auto &timer = nodes[index];
+    const auto delay = timer.expires > base ? timer.expires - base : 0;
+    const auto expires = delay < horizon ? std::max(timer.expires, base) : base + horizon - 1;
+
+    std::size_t level = 0;
+    while (level + 1 < Levels && (delay >> (SlotBits * (level + 1))) != 0) { ++level; }
+    const std::size_t slot = (expires >> (SlotBits * level)) & slot_mask;
+
+    timer.level = static_cast<std::uint8_t>(level);
+    timer.slot = static_cast<std::uint8_t>(slot);
+    timer.prev = npos;
+    timer.next = heads[level][slot];
+    if (timer.next != npos) { nodes[timer.next].prev = index; }
+    heads[level][slot] = index;
+    occupied[level] |= std::uint64_t{ 1 } << slot;
+  }
+
+  constexpr void unlink(const std::uint32_t index) noexcept
+  {
+    auto &timer = nodes[index];
+    if (timer.prev == npos) {
+      heads[timer.level][timer.slot] = timer.next;
+      if (timer.next == npos) { occupied[timer.level] &= ~(std::uint64_t{ 1 } << timer.slot); }
+    } else {
+      nodes[timer.prev].next = timer.next;
+    }
+    if (timer.next != npos) { nodes[timer.next].prev = timer.prev; }
+  }
+
+  constexpr void release(const std::uint32_t index) noexcept
+  {
+    auto &timer = nodes[index];
+    ++timer.generation;
+    timer.next = free_head;
+    free_head = index;
+    --live;
+  }
+
+  // takes the whole bucket, leaving it empty
+  [[nodiscard]] constexpr std::uint32_t detach(const std::size_t level, const std::size_t slot) noexcept
+  {
+    occupied[level] &= ~(std::uint64_t{ 1 } << slot);
+    return std::exchange(heads[level][slot], npos);
+  }
+
+  // the lowest level just wrapped: pull the bucket now due out of each level
+  // above, for as long as those wrap too
+  constexpr void cascade() noexcept
+  {
+    for (std::size_t level = 1; level < Levels; ++level) {
+      const std::size_t slot = (current >> (SlotBits * level)) & slot_mask;
+      for (auto index = detach(level, slot); index != npos;) {
+        const auto next = nodes[index].next;
+        link(index, current);
+        index = next;
+      }
+      if (slot != 0) { break; }
+    }
+  }
+
+  template<typename Scheduler> constexpr std::size_t expire(Scheduler &tasks, const std::size_t slot)
+  {
+    std::size_t woken = 0;
+    for (auto index = detach(0, slot); index != npos;) {
+      const auto next = nodes[index].next;
+      if (nodes[index].expires > current) {
+        // parked past the horizon of a single level wheel
+        link(index, current + 1);
+      } else {
+        woken += tasks.notify_all(nodes[index].sleepers);
+        release(index);
+      }
+      index = next;
+    }
+    return woken;
+  }
+
+  simple_stack_vector<node, Capacity> nodes;
+  std::array<std::array<std::uint32_t, slot_count>, Levels> heads = [] {
+    std::array<std::array<std::uint32_t, slot_count>, Levels> result{};
+    for (auto &level : result) { level.fill(npos); }
+    return result;
+  }();
+  std::array<std::uint64_t, Levels> occupied{};
+  std::uint64_t current = 0;
+  std::uint32_t free_head = npos;
+  std::size_t live = 0;
+};
+
+}// namespace lefticus::tools::lambda_coroutines
+
+#endif// LEFTICUS_TOOLS_TIMER_WHEEL_HPP
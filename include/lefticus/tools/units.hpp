@@ -0,0 +1,226 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+#ifndef LEFTICUS_TOOLS_UNITS_HPP
+#define LEFTICUS_TOOLS_UNITS_HPP
+
+#include "strong_types.hpp"
+#include "type_lists.hpp"
+
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+
+namespace lefticus::tools::units {
+
+// Dimensional analysis on top of strong_alias. A dimension is a type_list of
+// exponents over the seven SI base dimensions, a quantity is a strong_alias
+// tagged with its dimension and scale, and the add / multiply / ... declarations
+// strong_alias needs are provided here as templates, so every product and
+// quotient type is derived rather than written out. Everything is resolved at
+// compile time; a quantity is a Rep at runtime.
+
+template<int... Exponents> using exponents = type_list<std::integral_constant<int, Exponents>...>;
+
+// exponent order: length, mass, duration, current, temperature, amount, luminosity
+using dimensionless = exponents<0, 0, 0, 0, 0, 0, 0>;
+using length = exponents<1, 0, 0, 0, 0, 0, 0>;
+using mass = exponents<0, 1, 0, 0, 0, 0, 0>;
+using duration = exponents<0, 0, 1, 0, 0, 0, 0>;
+using current = exponents<0, 0, 0, 1, 0, 0, 0>;
+using temperature = exponents<0, 0, 0, 0, 1, 0, 0>;
+using amount = exponents<0, 0, 0, 0, 0, 1, 0>;
+using luminosity = exponents<0, 0, 0, 0, 0, 0, 1>;
+
+template<typename... LHS, typename... RHS>
+  requires(sizeof...(LHS) == sizeof...(RHS))
+auto dimension_product(type_list<LHS...>, type_list<RHS...>)
+  -> type_list<std::integral_constant<int, LHS::value + RHS::value>...>;
+
+template<typename... LHS, typename... RHS>
+  requires(sizeof...(LHS) == sizeof...(RHS))
+auto dimension_quotient(type_list<LHS...>, type_list<RHS...>)
+  -> type_list<std::integral_constant<int, LHS::value - RHS::value>...>;
+
+template<int Power, typename... Exponent>
+auto dimension_power(type_list<Exponent...>) -> type_list<std::integral_constant<int, Exponent::value * Power>...>;
+
+template<typename LHS, typename RHS> using product_t = decltype(dimension_product(LHS{}, RHS{}));
+template<typename LHS, typename RHS> using quotient_t = decltype(dimension_quotient(LHS{}, RHS{}));
+template<typename Dimension, int Power> using power_t = decltype(dimension_power<Power>(Dimension{}));
+
+template<typename Dimension, std::size_t Index> inline constexpr int exponent_v = nth_t<Index, Dimension>::value;
+
+using area = power_t<length, 2>;
+using volume = power_t<length, 3>;
+using frequency = quotient_t<dimensionless, duration>;
+using velocity = quotient_t<length, duration>;
+using acceleration = quotient_t<velocity, duration>;
+using force = product_t<mass, acceleration>;
+using energy = product_t<force, length>;
+using power = quotient_t<energy, duration>;
+using charge = product_t<current, duration>;
+
+// The strong_alias tag of a quantity. Scale is a std::ratio relative to the
+// coherent SI unit, so kilometres are unit<length, std::kilo>.
+template<typename Dimension, typename Scale> struct unit
+{
+  using dimension = Dimension;
+  using scale = Scale;
+};
+
+template<typename Dimension, typename Scale = std::ratio<1>, typename Rep = double>
+using quantity = strong_alias<Rep, unit<Dimension, Scale>>;
+
+template<typename Type> struct quantity_traits
+{
+};
+
+template<typename Rep, typename Dimension, typename Scale> struct quantity_traits<quantity<Dimension, Scale, Rep>>
+{
+  using rep = Rep;
+  using dimension = Dimension;
+  using scale = Scale;
+};
+
+template<typename Type>
+concept is_quantity = requires { typename quantity_traits<std::remove_cvref_t<Type>>::rep; };
+
+template<typename LHS, typename RHS>
+concept same_dimension = is_quantity<LHS> && is_quantity<RHS>
+                         && std::is_same_v<typename quantity_traits<std::remove_cvref_t<LHS>>::dimension,
+                           typename quantity_traits<std::remove_cvref_t<RHS>>::dimension>;
+
+// Only declared, these are found by ADL from the strong_alias operators
+template<typename Dimension, typename Scale, typename Rep>
+auto add(quantity<Dimension, Scale, Rep>, quantity<Dimension, Scale, Rep>) -> quantity<Dimension, Scale, Rep>;
+
+template<typename Dimension, typename Scale, typename Rep>
+auto subtract(quantity<Dimension, Scale, Rep>, quantity<Dimension, Scale, Rep>) -> quantity<Dimension, Scale, Rep>;
+
+template<typename Dimension, typename Scale, typename Rep>
+auto negate(quantity<Dimension, Scale, Rep>) -> quantity<Dimension, Scale, Rep>;
+
+template<typename Dimension, typename Scale, typename Rep>
+auto order(quantity<Dimension, Scale, Rep>, quantity<Dimension, Scale, Rep>) -> bool;
+
+template<typename Dimension, typename Scale, typename Rep>
+auto equate(quantity<Dimension, Scale, Rep>, quantity<Dimension, Scale, Rep>) -> bool;
+
+template<typename LHSDimension, typename LHSScale, typename RHSDimension, typename RHSScale, typename Rep>
+auto multiply(quantity<LHSDimension, LHSScale, Rep>, quantity<RHSDimension, RHSScale, Rep>)
+  -> quantity<product_t<LHSDimension, RHSDimension>, std::ratio_multiply<LHSScale, RHSScale>, Rep>;
+
+template<typename LHSDimension, typename LHSScale, typename RHSDimension, typename RHSScale, typename Rep>
+auto divide(quantity<LHSDimension, LHSScale, Rep>, quantity<RHSDimension, RHSScale, Rep>)
+  -> quantity<quotient_t<LHSDimension, RHSDimension>, std::ratio_divide<LHSScale, RHSScale>, Rep>;
+
+// Scaling by a plain number keeps the unit
+template<typename Dimension, typename Scale, typename Rep>
+[[nodiscard]] constexpr auto operator*(const quantity<Dimension, Scale, Rep> &lhs, std::type_identity_t<Rep> rhs)
+  -> quantity<Dimension, Scale, Rep>
+{
+  return quantity<Dimension, Scale, Rep>{ lhs.get() * rhs };
+}
+
+template<typename Dimension, typename Scale, typename Rep>
+[[nodiscard]] constexpr auto operator*(std::type_identity_t<Rep> lhs, const quantity<Dimension, Scale, Rep> &rhs)
+  -> quantity<Dimension, Scale, Rep>
+{
+  return quantity<Dimension, Scale, Rep>{ lhs * rhs.get() };
+}
+
+template<typename Dimension, typename Scale, typename Rep>
+[[nodiscard]] constexpr auto operator/(const quantity<Dimension, Scale, Rep> &lhs, std::type_identity_t<Rep> rhs)
+  -> quantity<Dimension, Scale, Rep>
+{
+  return quantity<Dimension, Scale, Rep>{ lhs.get() / rhs };
+}
+
+template<typename Dimension, typename Scale, typename Rep>
+[[nodiscard]] constexpr auto operator/(std::type_identity_t<Rep> lhs, const quantity<Dimension, Scale, Rep> &rhs)
+{
+  using result = quantity<quotient_t<dimensionless, Dimension>, std::ratio_divide<std::ratio<1>, Scale>, Rep>;
+  return result{ lhs / rhs.get() };
+}
+
+// Converts between scales of the same dimension. The factor is a
+// compile-time constant, so this is at most one multiply or divide.
+template<typename To, typename From>
+[[nodiscard]] constexpr auto quantity_cast(const From &from) -> To
+  requires(same_dimension<To, From>)
+{
+  using to_rep = typename quantity_traits<To>::rep;
+  using factor = std::ratio_divide<typename quantity_traits<From>::scale, typename quantity_traits<To>::scale>;
+  using common = std::common_type_t<to_rep, typename quantity_traits<From>::rep, std::intmax_t>;
+
+  const auto value = static_cast<common>(from.get());
+  if constexpr (factor::num == 1 && factor::den == 1) {
+    return To{ static_cast<to_rep>(value) };
+  } else if constexpr (factor::den == 1) {
+    return To{ static_cast<to_rep>(value * static_cast<common>(factor::num)) };
+  } else if constexpr (factor::num == 1) {
+    return To{ static_cast<to_rep>(value / static_cast<common>(factor::den)) };
+  } else {
+    return To{ static_cast<to_rep>(value * static_cast<common>(factor::num) / static_cast<common>(factor::den)) };
+  }
+}
+
+using scalar = quantity<dimensionless>;
+
+using metres = quantity<length>;
+using kilometres = quantity<length, std::kilo>;
+using millimetres = quantity<length, std::milli>;
+using square_metres = quantity<area>;
+using cubic_metres = quantity<volume>;
+
+using kilograms = quantity<mass>;
+using grams = quantity<mass, std::milli>;
+
+using seconds = quantity<duration>;
+using milliseconds = quantity<duration, std::milli>;
+using minutes = quantity<duration, std::ratio<60>>;// NOLINT Magic Number
+using hours = quantity<duration, std::ratio<3600>>;// NOLINT Magic Number
+
+using amperes = quantity<current>;
+using kelvins = quantity<temperature>;
+using moles = quantity<amount>;
+using candelas = quantity<luminosity>;
+
+using hertz = quantity<frequency>;
+using metres_per_second = quantity<velocity>;
+using kilometres_per_hour = quantity<velocity, std::ratio_divide<std::kilo, std::ratio<3600>>>;// NOLINT Magic Number
+using metres_per_second_squared = quantity<acceleration>;
+using newtons = quantity<force>;
+using joules = quantity<energy>;
+using watts = quantity<power>;
+using coulombs = quantity<charge>;
+
+}// namespace lefticus::tools::units
+
+#endif// LEFTICUS_TOOLS_UNITS_HPP
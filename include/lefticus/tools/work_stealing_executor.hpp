@@ -0,0 +1,373 @@
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <https://unlicense.org>
+*/
+
+
+
+#ifndef LEFTICUS_TOOLS_WORK_STEALING_EXECUTOR_HPP
+#define LEFTICUS_TOOLS_WORK_STEALING_EXECUTOR_HPP
+
+#include "lambda_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace lefticus::tools::lambda_coroutines {
+
+// Chase-Lev work-stealing deque of task indexes, in the C11 formulation of
+// Lê, Pop, Cohen and Zappa Nardelli. The owning worker pushes and pops at
+// the bottom and any thread may steal from the top. The capacity is fixed.
+class work_stealing_deque
+{
+public:
+  explicit work_stealing_deque(const std::size_t capacity)
+    : mask{ std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1 },
+      buffer{ std::make_unique<std::atomic<std::uint32_t>[]>(mask + 1) }
+  {}
+
+  // owner only, false if the deque is full
+  bool push(const std::uint32_t value) noexcept
+  {
+    const auto back = bottom.load(std::memory_order_relaxed);
+    const auto front = top.load(std::memory_order_acquire);
+    if (back - front > static_cast<std::int64_t>(mask)) { return false; }
+    slot(back).store(value, std::memory_order_relaxed);
+    // publishes the value, and everything the task wrote, to thieves
+    bottom.store(back + 1, std::memory_order_release);
+    return true;
+  }
+
+  // owner only, takes the most recently pushed value
+  [[nodiscard]] std::optional<std::uint32_t> pop() noexcept
+  {
+    const auto back = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(back, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto front = top.load(std::memory_order_relaxed);
+
+    if (front > back) {
+      bottom.store(back + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+
+    const auto value = slot(back).load(std::memory_order_relaxed);
+    if (front == back) {
+      // the last value, race any thieves for it
+      const bool won =
+        top.compare_exchange_strong(front, front + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom.store(back + 1, std::memory_order_relaxed);
+      if (!won) { return std::nullopt; }
+    }
+    return value;
+  }
+
+  // any thread, takes the least recently pushed value. Also returns
+  // nothing if another thread took that value first.
+  [[nodiscard]] std::optional<std::uint32_t> steal() noexcept
+  {
+    auto front = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto back = bottom.load(std::memory_order_acquire);
+    if (front >= back) { return std::nullopt; }
+
+    const auto value = slot(front).load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(front, front + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+  }
+
+private:
+  [[nodiscard]] std::atomic<std::uint32_t> &slot(const std::int64_t position) const noexcept
+  {
+    return buffer[static_cast<std::size_t>(position) & mask];
+  }
+
+  // thieves hammer top and the owner hammers bottom, keep them on separate cache lines
+  alignas(64) std::atomic<std::int64_t> top{ 0 };
+  alignas(64) std::atomic<std::int64_t> bottom{ 0 };
+  std::size_t mask;
+  std::unique_ptr<std::atomic<std::uint32_t>[]> buffer;
+};
+
+// Runs up to Capacity lambda coroutines of type Task on a pool of worker
+// threads, each with its own work_stealing_deque. An idle worker steals
+// from the others, so tasks migrate freely; a lambda coroutine's whole
+// state is in its captures, which stay put in the executor while only
+// its index moves.
+//
+// Tasks are called with no arguments or with the executor, and return a
+// task_step. A worker pops fresh tasks LIFO from its own deque without
+// contention. Tasks that yield() wait in a per-worker list until the deque
+// runs dry and are then pushed back onto it, so every yielded task runs
+// once more before any runs twice and thieves can still take them. done()
+// frees the task's slot. A wait_queue belongs to a single-threaded
+// scheduler, so returning wait() throws std::logic_error.
+//
+// A worker that finds nothing to run spins briefly, then sleeps until a
+// task is pushed, the last task finishes or a stop is requested.
+template<typename Task, std::size_t Capacity> class work_stealing_executor
+{
+  static_assert(Capacity < wait_queue::npos, "task indexes must fit in 32 bits");
+
+  static constexpr std::uint32_t npos = wait_queue::npos;
+
+  struct worker_context
+  {
+    const work_stealing_executor *executor = nullptr;
+    std::size_t index = 0;
+  };
+
+  // which worker of which executor the current thread is
+  static inline thread_local worker_context current_worker{};
+
+public:
+  explicit work_stealing_executor(const std::size_t worker_count = std::max(std::thread::hardware_concurrency(), 1U))
+    : slots(Capacity)
+  {
+    if (worker_count == 0) { throw std::invalid_argument("work_stealing_executor needs at least one worker"); }
+    workers.reserve(worker_count);
+    for (std::size_t index = 0; index < worker_count; ++index) {
+      workers.push_back(std::make_unique<worker_queues>(Capacity));
+    }
+    for (std::uint32_t index = 0; index < Capacity; ++index) {
+      slots[index].next_free = index + 1 == Capacity ? npos : index + 1;
+    }
+    free_head = Capacity == 0 ? npos : 0;
+  }
+
+  [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Capacity; }
+  [[nodiscard]] std::size_t worker_count() const noexcept { return workers.size(); }
+  // tasks that have been spawned and are not yet done
+  [[nodiscard]] std::size_t size() const noexcept { return live.load(std::memory_order_acquire); }
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  // From inside a task the new task goes on the current worker's queue.
+  // Otherwise the executor must not be running, and tasks are dealt to
+  // the workers in turn.
+  void spawn(Task task)
+  {
+    const bool on_worker = current_worker.executor == this;
+    if (!on_worker && running.load(std::memory_order_acquire)) {
+      throw std::logic_error("spawn from outside a running work_stealing_executor");
+    }
+
+    const auto index = allocate(std::move(task));
+    live.fetch_add(1, std::memory_order_relaxed);
+    const auto worker = on_worker ? current_worker.index : next_worker++ % workers.size();
+    // cannot fail, every deque can hold every task
+    workers[worker]->tasks.push(index);
+    if (on_worker) { notify_work(); }
+  }
+
+  // Runs until every task is done or request_stop() is called, using the
+  // calling thread as the first worker. Tasks still queued when stopped
+  // resume on the next call. If a task throws, that task is destroyed,
+  // the other workers stop, and the exception is rethrown here.
+  void run()
+  {
+    stopping.store(false, std::memory_order_relaxed);
+    running.store(true, std::memory_order_release);
+    failure = nullptr;
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers.size() - 1);
+    for (std::size_t index = 1; index < workers.size(); ++index) {
+      threads.emplace_back([this, index] { work(index); });
+    }
+    work(0);
+    for (auto &thread : threads) { thread.join(); }
+
+    running.store(false, std::memory_order_release);
+    if (failure) { std::rethrow_exception(failure); }
+  }
+
+  // asks every worker to return after the task it is running, callable from any thread
+  void request_stop() noexcept
+  {
+    stopping.store(true, std::memory_order_relaxed);
+    notify_work();
+  }
+
+private:
+  struct slot
+  {
+    std::optional<Task> task;
+    std::uint32_t next_free = npos;
+  };
+
+  struct worker_queues
+  {
+    explicit worker_queues(const std::size_t capacity) : tasks{ capacity } { yielded.reserve(capacity); }
+
+    work_stealing_deque tasks;
+    // owner only, the tasks that yielded since the deque last ran dry
+    std::vector<std::uint32_t> yielded;
+  };
+
+  // how many times an idle worker looks for work before it sleeps
+  static constexpr std::size_t idle_spins = 64;
+
+  [[nodiscard]] std::uint32_t allocate(Task task)
+  {
+    const std::scoped_lock lock{ free_mutex };
+    if (free_head == npos) { throw std::length_error("work_stealing_executor is full"); }
+    const auto index = free_head;
+    slots[index].task.emplace(std::move(task));
+    free_head = slots[index].next_free;
+    return index;
+  }
+
+  void release(const std::uint32_t index) noexcept
+  {
+    slots[index].task.reset();
+    {
+      const std::scoped_lock lock{ free_mutex };
+      slots[index].next_free = free_head;
+      free_head = index;
+    }
+    if (live.fetch_sub(1, std::memory_order_release) == 1) { notify_work(); }
+  }
+
+  // wakes the sleeping workers, called whenever there may be something new for them to do
+  void notify_work() noexcept
+  {
+    work_signal.fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_seq_cst) != 0) { work_signal.notify_all(); }
+  }
+
+  // pushes the yielded tasks back onto the drained deque, oldest on top
+  [[nodiscard]] bool requeue_yielded(worker_queues &queues) noexcept
+  {
+    if (queues.yielded.empty()) { return false; }
+    // in reverse, so the owner pops them in the order they yielded
+    for (auto index = queues.yielded.rbegin(); index != queues.yielded.rend(); ++index) { queues.tasks.push(*index); }
+    queues.yielded.clear();
+    notify_work();
+    return true;
+  }
+
+  void work(const std::size_t worker) noexcept
+  {
+    current_worker = worker_context{ this, worker };
+    auto &own = *workers[worker];
+    try {
+      // rotates through the other workers so thieves spread out
+      std::size_t victim = worker;
+      std::size_t idle = 0;
+      while (true) {
+        // read before anything is checked, so whatever changes afterwards also changes it
+        const auto seen = work_signal.load(std::memory_order_acquire);
+        if (stopping.load(std::memory_order_relaxed) || live.load(std::memory_order_acquire) == 0) { break; }
+
+        auto index = own.tasks.pop();
+        if (!index && requeue_yielded(own)) { index = own.tasks.pop(); }
+        for (std::size_t attempt = 1; !index && attempt < workers.size(); ++attempt) {
+          victim = (victim + 1) % workers.size();
+          if (victim != worker) { index = workers[victim]->tasks.steal(); }
+        }
+
+        if (index) {
+          idle = 0;
+          resume(own, *index);
+        } else if (++idle < idle_spins) {
+          std::this_thread::yield();
+        } else {
+          sleeping.fetch_add(1, std::memory_order_seq_cst);
+          work_signal.wait(seen, std::memory_order_seq_cst);
+          sleeping.fetch_sub(1, std::memory_order_relaxed);
+          idle = 0;
+        }
+      }
+    } catch (...) {
+      {
+        const std::scoped_lock lock{ free_mutex };
+        if (!failure) { failure = std::current_exception(); }
+      }
+      stopping.store(true, std::memory_order_relaxed);
+      notify_work();
+    }
+    current_worker = worker_context{};
+  }
+
+  void resume(worker_queues &own, const std::uint32_t index)
+  {
+    auto &task = *slots[index].task;
+    task_step step;
+    try {
+      if constexpr (std::is_invocable_v<Task &, work_stealing_executor &>) {
+        step = task(*this);
+      } else {
+        step = task();
+      }
+      if (step.action == task_step::kind::wait) {
+        throw std::logic_error("work_stealing_executor tasks cannot wait on a wait_queue");
+      }
+    } catch (...) {
+      release(index);
+      throw;
+    }
+
+    if (step.action == task_step::kind::yield) {
+      own.yielded.push_back(index);
+    } else {
+      release(index);
+    }
+  }
+
+  std::vector<slot> slots;
+  std::vector<std::unique_ptr<worker_queues>> workers;
+  std::mutex free_mutex;
+  std::uint32_t free_head = npos;
+  std::size_t next_worker = 0;
+  std::atomic<std::size_t> live{ 0 };
+  std::atomic<bool> stopping{ false };
+  std::atomic<bool> running{ false };
+  // bumped by notify_work, sleeping workers wait for it to change
+  std::atomic<std::uint32_t> work_signal{ 0 };
+  std::atomic<std::size_t> sleeping{ 0 };
+  std::exception_ptr failure;
+};
+
+}// namespace lefticus::tools::lambda_coroutines
+
+#endif// LEFTICUS_TOOLS_WORK_STEALING_EXECUTOR_HPP
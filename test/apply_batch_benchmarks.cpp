@@ -0,0 +1,42 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/apply_batch.hpp>
+#include <lefticus/tools/curry.hpp>
+
+#include <cstddef>
+#include <vector>
+
+// Scoring rows of struct-of-arrays data through a partially applied curry,
+// one call at a time and batched
+
+namespace {
+constexpr std::size_t row_count = 1 << 22;
+
+constexpr auto score = [](double weight, double bias, double value, double count) {
+  return weight * value + bias * count;
+};
+}// namespace
+
+TEST_CASE("[apply_batch] scoring rows", "[!benchmark]")
+{
+  std::vector<double> values(row_count);
+  std::vector<double> counts(row_count);
+  for (std::size_t index = 0; index < row_count; ++index) {
+    values[index] = static_cast<double>(index) * 0.25;// NOLINT Magic Number
+    counts[index] = static_cast<double>(index % 13);// NOLINT Magic Number
+  }
+  std::vector<double> output(row_count);
+  const auto scorer = lefticus::tools::curry(score, 2.0, 1.5);// NOLINT Magic Number
+
+  BENCHMARK("one call at a time")
+  {
+    for (std::size_t index = 0; index < row_count; ++index) { output[index] = scorer(values[index], counts[index]); }
+    return output.back();
+  };
+
+  BENCHMARK("apply_batch sequential")
+  {
+    return lefticus::tools::apply_batch(lefticus::tools::batch_sequential, scorer, output, values, counts).back();
+  };
+
+  BENCHMARK("apply_batch parallel") { return lefticus::tools::apply_batch(scorer, output, values, counts).back(); };
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/apply_batch.hpp>
+#include <lefticus/tools/curry.hpp>
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+constexpr double score(double weight, double bias, double value, int count)
+{
+  return weight * value + bias * count;
+}
+
+struct rows
+{
+  std::vector<double> values;
+  std::vector<int> counts;
+
+  explicit rows(const std::size_t size)
+  {
+    for (std::size_t index = 0; index < size; ++index) {
+      values.push_back(static_cast<double>(index) * 0.5);// NOLINT Magic Number
+      counts.push_back(static_cast<int>(index % 7));// NOLINT Magic Number
+    }
+  }
+};
+}// namespace
+
+TEST_CASE("[apply_batch] calls a curried function once per row")
+{
+  const auto scorer = lefticus::tools::curry(score, 2.0, 1.0);
+  const rows input{ 100 };
+  std::array<double, 128> output{};// NOLINT Magic Number
+
+  const auto written = lefticus::tools::apply_batch(
+    lefticus::tools::batch_sequential, scorer, output, input.values, input.counts);
+
+  REQUIRE(written.size() == 100);
+  REQUIRE(written.data() == output.data());
+  for (std::size_t index = 0; index < written.size(); ++index) {
+    REQUIRE(written[index] == score(2.0, 1.0, input.values[index], input.counts[index]));
+  }
+}
+
+TEST_CASE("[apply_batch] parallel chunks match the sequential result")
+{
+  const auto scorer = lefticus::tools::flat_curry(score, 0.25, 3.0);
+  const rows input{ 10007 };// NOLINT Magic Number
+  std::vector<double> sequential(input.values.size());
+  std::vector<double> parallel(input.values.size());
+
+  lefticus::tools::apply_batch(lefticus::tools::batch_sequential, scorer, sequential, input.values, input.counts);
+  // small chunks so that this size really is split across threads
+  const auto written = lefticus::tools::apply_batch(
+    lefticus::tools::batch_parallel{ 100, 4 }, scorer, parallel, input.values, input.counts);// NOLINT Magic Number
+
+  REQUIRE(written.size() == parallel.size());
+  REQUIRE(parallel == sequential);
+
+  std::vector<double> defaulted(input.values.size());
+  lefticus::tools::apply_batch(scorer, defaulted, input.values, input.counts);
+  REQUIRE(defaulted == sequential);
+}
+
+TEST_CASE("[apply_batch] rejects mismatched sizes")
+{
+  const auto scorer = lefticus::tools::curry(score, 1.0, 1.0);
+  const std::vector<double> values(10);// NOLINT Magic Number
+  const std::vector<int> counts(9);// NOLINT Magic Number
+  const std::vector<int> enough(10);// NOLINT Magic Number
+  std::vector<double> output(10);// NOLINT Magic Number
+  std::vector<double> short_output(5);// NOLINT Magic Number
+
+  CHECK_THROWS_AS(lefticus::tools::apply_batch(scorer, output, values, counts), std::invalid_argument);
+  CHECK_THROWS_AS(lefticus::tools::apply_batch(scorer, short_output, values, enough), std::length_error);
+}
+
+TEST_CASE("[apply_batch] rethrows exceptions from worker threads")
+{
+  const rows input{ 1000 };// NOLINT Magic Number
+  std::vector<double> output(input.values.size());
+  const auto failing = [](double value, int) {
+    if (value > 400.0) { throw std::domain_error("too large"); }// NOLINT Magic Number
+    return value;
+  };
+
+  CHECK_THROWS_AS(lefticus::tools::apply_batch(
+                    lefticus::tools::batch_parallel{ 10, 4 }, failing, output, input.values, input.counts),// NOLINT
+    std::domain_error);
+}
@@ -0,0 +1,35 @@
+#include <lefticus/tools/apply_batch.hpp>
+#include <lefticus/tools/curry.hpp>
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+// Pairs of raw_* / batch_* functions that must compile to the same
+// instructions, see test/CMakeLists.txt.
+
+namespace {
+// a lambda rather than a function, which curry would hold as a pointer that GCC does not inline through
+constexpr auto score = [](double weight, double bias, double value, double count) {
+  return weight * value + bias * count;
+};
+}// namespace
+
+// NOLINTBEGIN
+extern "C" {
+void raw_score(double *out, std::size_t out_size, const double *values, const double *counts, std::size_t size)
+{
+  if (out_size < size) { throw std::length_error("apply_batch output is too small"); }
+  for (std::size_t index = 0; index < size; ++index) { out[index] = score(2.0, 1.5, values[index], counts[index]); }
+}
+
+void batch_score(double *out, std::size_t out_size, const double *values, const double *counts, std::size_t size)
+{
+  lefticus::tools::apply_batch(lefticus::tools::batch_sequential,
+    lefticus::tools::curry(score, 2.0, 1.5),
+    std::span{ out, out_size },
+    std::span{ values, size },
+    std::span{ counts, size });
+}
+}
+// NOLINTEND
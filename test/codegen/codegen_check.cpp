@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Usage: codegen_check <file.s> <reference> <candidate> [<reference> <candidate>]...
+//
+// Fails if a candidate function uses an instruction the reference does not,
+// or more instructions in total. Register allocation and block ordering are
+// free to differ, so only mnemonics are compared; data movement, and returns
+// that block ordering may merge, are allowed to shrink, never to grow.
+
+namespace {
+using instruction_counts = std::map<std::string, int>;
+
+std::string_view trim(std::string_view str)
+{
+  const auto first = str.find_first_not_of(" \t");
+  if (first == std::string_view::npos) { return {}; }
+  const auto last = str.find_last_not_of(" \t\r");
+  return str.substr(first, last - first + 1);
+}
+
+bool is_function_label(std::string_view line, std::string_view name)
+{
+  // Mach-O prefixes C symbols with an underscore
+  if (line.starts_with('_') && !name.starts_with('_')) { line.remove_prefix(1); }
+  return line.size() == name.size() + 1 && line.starts_with(name) && line.ends_with(':');
+}
+
+bool ends_function(std::string_view line)
+{
+  return line.starts_with(".cfi_endproc") || line.starts_with(".size") || line.starts_with(".Lfunc_end");
+}
+
+// an empty result means the function was not found
+instruction_counts read_function(const std::vector<std::string> &lines, std::string_view name)
+{
+  instruction_counts result;
+  auto line = std::find_if(lines.begin(), lines.end(), [&](const auto &str) { return is_function_label(str, name); });
+  if (line == lines.end()) { return result; }
+
+  for (++line; line != lines.end(); ++line) {
+    const auto text = trim(*line);
+    if (ends_function(text)) { break; }
+    if (text.empty() || text.ends_with(':') || text.starts_with('.') || text.starts_with('#')
+        || text.starts_with("//")) {
+      continue;
+    }
+    ++result[std::string{ text.substr(0, text.find_first_of(" \t")) }];
+  }
+  return result;
+}
+
+bool may_shrink(std::string_view mnemonic)
+{
+  return mnemonic.starts_with("mov") || mnemonic.starts_with("lea") || mnemonic == "nop" || mnemonic == "xchg"
+         || mnemonic == "ret";
+}
+
+int total(const instruction_counts &counts)
+{
+  int result = 0;
+  for (const auto &[mnemonic, count] : counts) { result += count; }
+  return result;
+}
+
+bool compare(const std::vector<std::string> &lines, std::string_view reference, std::string_view candidate)
+{
+  const auto expected = read_function(lines, reference);
+  const auto actual = read_function(lines, candidate);
+  if (expected.empty() || actual.empty()) {
+    std::cerr << "could not find '" << reference << "' and '" << candidate << "'\n";
+    return false;
+  }
+
+  bool passed = true;
+  for (const auto &[mnemonic, count] : actual) {
+    const auto found = expected.find(mnemonic);
+    const int expected_count = found == expected.end() ? 0 : found->second;
+    if (may_shrink(mnemonic) ? count > expected_count : count != expected_count) {
+      std::cerr << candidate << ": " << count << " x " << mnemonic << ", " << reference << ": " << expected_count
+                << '\n';
+      passed = false;
+    }
+  }
+  for (const auto &[mnemonic, count] : expected) {
+    if (!may_shrink(mnemonic) && !actual.contains(mnemonic)) {
+      std::cerr << candidate << ": missing " << mnemonic << " used by " << reference << '\n';
+      passed = false;
+    }
+  }
+  if (total(actual) > total(expected)) {
+    std::cerr << candidate << ": " << total(actual) << " instructions, " << reference << ": " << total(expected)
+              << '\n';
+    passed = false;
+  }
+
+  std::cout << (passed ? "ok     " : "FAILED ") << candidate << " vs " << reference << '\n';
+  return passed;
+}
+}// namespace
+
+int main(int argc, const char *argv[])
+{
+  const std::span<const char *> args(argv, static_cast<std::size_t>(argc));
+  if (args.size() < 4 || args.size() % 2 != 0) {
+    std::cerr << "usage: codegen_check <file.s> <reference> <candidate> [<reference> <candidate>]...\n";
+    return EXIT_FAILURE;
+  }
+
+  std::ifstream file(args[1]);
+  if (!file) {
+    std::cerr << "unable to open " << args[1] << '\n';
+    return EXIT_FAILURE;
+  }
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) { lines.emplace_back(trim(line)); }
+
+  bool passed = true;
+  for (std::size_t index = 2; index < args.size(); index += 2) {
+    passed = compare(lines, args[index], args[index + 1]) && passed;
+  }
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
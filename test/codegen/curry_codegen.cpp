@@ -0,0 +1,32 @@
+#include <lefticus/tools/curry.hpp>
+
+#include <cstddef>
+#include <functional>
+
+// Pairs of raw_* / curried_* functions that must compile to the same
+// instructions, see test/CMakeLists.txt.
+
+namespace {
+constexpr int weigh(int a, int b, int c, int d) { return a * 3 + b * 5 + c * 7 + d; }
+}// namespace
+
+// NOLINTBEGIN
+extern "C" {
+int raw_weigh(int a, int b, int c, int d) { return weigh(a, b, c, d); }
+
+int curried_weigh(int a, int b, int c, int d) { return lefticus::tools::flat_curry(weigh)(a)(b, c)(d); }
+
+void raw_accumulate(int *total, const int *values, std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) { *total += values[index] * 3; }
+}
+
+void curried_accumulate(int *total, const int *values, std::size_t count)
+{
+  const auto add_to = lefticus::tools::flat_curry([](int &target, int scale, int value) { target += value * scale; },
+    std::ref(*total),
+    3);
+  for (std::size_t index = 0; index < count; ++index) { add_to(values[index]); }
+}
+}
+// NOLINTEND
@@ -0,0 +1,88 @@
+#include <lefticus/tools/strong_types.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+// Pairs of raw_* / strong_* functions that must compile to the same
+// instructions. This file is only ever compiled to assembly and inspected
+// by codegen_check, see test/CMakeLists.txt.
+
+using meters = lefticus::tools::strong_alias<double, struct meters_tag>;
+using seconds = lefticus::tools::strong_alias<double, struct seconds_tag>;
+using ratio = lefticus::tools::strong_alias<double, struct ratio_tag>;
+
+auto add(meters, meters) -> meters;
+auto multiply(meters, ratio) -> meters;
+auto order(seconds, seconds) -> bool;
+
+// NOLINTBEGIN
+extern "C" {
+void raw_add(double *out, const double *lhs, const double *rhs, std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) { out[index] = lhs[index] + rhs[index]; }
+}
+
+void strong_add(meters *out, const meters *lhs, const meters *rhs, std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) { out[index] = lhs[index] + rhs[index]; }
+}
+
+void raw_scale(double *values, double factor, std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) { values[index] = values[index] * factor; }
+}
+
+void strong_scale(meters *values, ratio factor, std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) { values[index] = values[index] * factor; }
+}
+
+void raw_sum(double *out, const double *values, std::size_t count)
+{
+  double total{};
+  for (std::size_t index = 0; index < count; ++index) { total = total + values[index]; }
+  *out = total;
+}
+
+void strong_sum(meters *out, const meters *values, std::size_t count)
+{
+  meters total{};
+  for (std::size_t index = 0; index < count; ++index) { total = total + values[index]; }
+  *out = total;
+}
+
+void raw_accumulate(double *out, const double *values, std::size_t count)
+{
+  double total{};
+  for (std::size_t index = 0; index < count; ++index) { total += values[index]; }
+  *out = total;
+}
+
+void strong_accumulate(meters *out, const meters *values, std::size_t count)
+{
+  meters total{};
+  for (std::size_t index = 0; index < count; ++index) { total += values[index]; }
+  *out = total;
+}
+
+void raw_count_before(std::size_t *out, const double *values, double limit, std::size_t count)
+{
+  std::size_t result = 0;
+  for (std::size_t index = 0; index < count; ++index) { result += values[index] < limit ? 1 : 0; }
+  *out = result;
+}
+
+void strong_count_before(std::size_t *out, const seconds *values, seconds limit, std::size_t count)
+{
+  std::size_t result = 0;
+  for (std::size_t index = 0; index < count; ++index) { result += values[index] < limit ? 1 : 0; }
+  *out = result;
+}
+
+// an element-wise loop of struct assignments is not vectorised by GCC, but
+// being trivially copyable lets std::copy use memmove, same as for double
+void raw_copy(double *out, const double *values, std::size_t count) { std::copy_n(values, count, out); }
+
+void strong_copy(meters *out, const meters *values, std::size_t count) { std::copy_n(values, count, out); }
+}
+// NOLINTEND
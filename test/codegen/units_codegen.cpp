@@ -0,0 +1,50 @@
+#include <lefticus/tools/units.hpp>
+
+#include <cstddef>
+
+// Pairs of raw_* / strong_* functions that must compile to the same
+// instructions, see test/CMakeLists.txt.
+
+namespace units = lefticus::tools::units;
+
+// NOLINTBEGIN
+extern "C" {
+void raw_speed(double *out, const double *distance, const double *time, std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) { out[index] = distance[index] / time[index]; }
+}
+
+void strong_speed(units::metres_per_second *out,
+  const units::metres *distance,
+  const units::seconds *time,
+  std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) { out[index] = distance[index] / time[index]; }
+}
+
+void raw_kinetic_energy(double *out, const double *mass, const double *speed, std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) { out[index] = 0.5 * mass[index] * speed[index] * speed[index]; }
+}
+
+void strong_kinetic_energy(units::joules *out,
+  const units::kilograms *mass,
+  const units::metres_per_second *speed,
+  std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) { out[index] = 0.5 * mass[index] * speed[index] * speed[index]; }
+}
+
+void raw_to_metres(double *out, const double *kilometres, std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) { out[index] = kilometres[index] * 1000.0; }
+}
+
+void strong_to_metres(units::metres *out, const units::kilometres *kilometres, std::size_t count)
+{
+  for (std::size_t index = 0; index < count; ++index) {
+    out[index] = units::quantity_cast<units::metres>(kilometres[index]);
+  }
+}
+}
+// NOLINTEND
@@ -25,3 +25,17 @@ TEST_CASE("[consteval_invoke] produces a constant expression")
   const auto value = lefticus::tools::consteval_invoke(Factorial, 3);// NOLINT
   STATIC_REQUIRE(value == 6);// NOLINT
 }
+
+TEST_CASE("[constant_cache] is a compile time constant")
+{
+  STATIC_REQUIRE(lefticus::tools::constant_cache<Factorial, 10U> == 3628800);// NOLINT
+  STATIC_REQUIRE(lefticus::tools::constant_cache<Factorial, 3U> == 6);// NOLINT
+}
+
+TEST_CASE("[constant_cache] is one object per argument set")
+{
+  constexpr auto square = [](int value) { return value * value; };
+  CHECK(&lefticus::tools::constant_cache<square, 4> == &lefticus::tools::constant_cache<square, 4>);
+  CHECK(&lefticus::tools::constant_cache<square, 4> != &lefticus::tools::constant_cache<square, 5>);
+  STATIC_REQUIRE(lefticus::tools::constant_cache<square, 5> == 25);// NOLINT
+}
@@ -1,6 +1,9 @@
 #include <catch2/catch.hpp>
 #include <lefticus/tools/curry.hpp>
 
+#include <functional>
+#include <utility>
+
 #ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
 #define CONSTEXPR
 #else
@@ -18,3 +21,71 @@ TEST_CASE("[curry] lambda")
   STATIC_REQUIRE(lefticus::tools::curry(func, 1)(2, 3) == 6);
   STATIC_REQUIRE(lefticus::tools::curry(func, 1, 2)(3) == 6);
 }
+
+namespace {
+// counts how often it is copied and moved
+struct tracked
+{
+  int value = 0;
+  int *copies = nullptr;
+  int *moves = nullptr;
+
+  constexpr tracked(int value_, int *copies_, int *moves_) : value(value_), copies(copies_), moves(moves_) {}
+  constexpr tracked(const tracked &other) : value(other.value), copies(other.copies), moves(other.moves)
+  {
+    ++*copies;
+  }
+  constexpr tracked(tracked &&other) noexcept : value(other.value), copies(other.copies), moves(other.moves)
+  {
+    ++*moves;
+  }
+  constexpr tracked &operator=(const tracked &) = delete;
+  constexpr tracked &operator=(tracked &&) = delete;
+  constexpr ~tracked() = default;
+};
+
+constexpr int sum_tracked(tracked a, tracked b, tracked c, tracked d) { return a.value + b.value + c.value + d.value; }
+}// namespace
+
+TEST_CASE("[flat_curry] lambda")
+{
+  CONSTEXPR auto func = [](int x, int y, int z) { return x + y + z; };
+
+  STATIC_REQUIRE(lefticus::tools::flat_curry(func, 1, 2, 3) == 6);
+  STATIC_REQUIRE(lefticus::tools::flat_curry(func)(1, 2, 3) == 6);
+  STATIC_REQUIRE(lefticus::tools::flat_curry(func, 1)(2, 3) == 6);
+  STATIC_REQUIRE(lefticus::tools::flat_curry(func, 1, 2)(3) == 6);
+  STATIC_REQUIRE(lefticus::tools::flat_curry(func)(1)(2)(3) == 6);
+}
+
+TEST_CASE("[flat_curry] partial applications can be reused")
+{
+  STATIC_REQUIRE([] {
+    const auto add_ten = lefticus::tools::flat_curry([](int x, int y, int z) { return x + y + z; }, 4, 6);
+    return add_ten(1) == 11 && add_ten(2) == 12;
+  }());
+}
+
+TEST_CASE("[flat_curry] never copies rvalue arguments")
+{
+  STATIC_REQUIRE([] {
+    int copies = 0;
+    int moves = 0;
+    const auto result = lefticus::tools::flat_curry(sum_tracked)(tracked{ 1, &copies, &moves })(
+      tracked{ 2, &copies, &moves })(tracked{ 3, &copies, &moves })(tracked{ 4, &copies, &moves });
+    // each partial application moves what is bound so far into the next curried,
+    // and the final call moves all four into the by-value parameters
+    return result == 10 && copies == 0 && moves == 1 + 2 + 3 + 4;
+  }());
+}
+
+TEST_CASE("[flat_curry] unwraps std::reference_wrapper")
+{
+  STATIC_REQUIRE([] {
+    int total = 0;
+    auto add_to = lefticus::tools::flat_curry([](int &target, int value) { target += value; }, std::ref(total));
+    add_to(3);
+    add_to(4);
+    return total == 7;
+  }());
+}
@@ -0,0 +1,52 @@
+#include <array>
+#include <catch2/catch.hpp>
+#include <lefticus/tools/eytzinger.hpp>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+
+constexpr auto make_eytzinger()
+{
+  constexpr std::array sorted{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };// NOLINT Magic Number
+  std::array<int, sorted.size()> result{};
+  lefticus::tools::to_eytzinger(sorted.begin(), sorted.end(), result.begin());
+  return result;
+}
+
+TEST_CASE("[eytzinger] to_eytzinger produces BFS order")
+{
+  CONSTEXPR auto result = make_eytzinger();
+
+  // root is the middle of an in-order traversal of the implicit tree
+  STATIC_REQUIRE(result == std::array{ 7, 4, 9, 2, 6, 8, 10, 1, 3, 5 });// NOLINT Magic Number
+}
+
+TEST_CASE("[eytzinger] eytzinger_lower_bound finds every key")
+{
+  CONSTEXPR auto data = make_eytzinger();
+
+  STATIC_REQUIRE(data[lefticus::tools::eytzinger_lower_bound(data, 1)] == 1);
+  STATIC_REQUIRE(data[lefticus::tools::eytzinger_lower_bound(data, 5)] == 5);// NOLINT Magic Number
+  STATIC_REQUIRE(data[lefticus::tools::eytzinger_lower_bound(data, 7)] == 7);// NOLINT Magic Number
+  STATIC_REQUIRE(data[lefticus::tools::eytzinger_lower_bound(data, 10)] == 10);// NOLINT Magic Number
+}
+
+TEST_CASE("[eytzinger] eytzinger_lower_bound handles missing keys")
+{
+  CONSTEXPR std::array sorted{ 10, 20, 30 };// NOLINT Magic Number
+  CONSTEXPR auto data = [&]() {
+    std::array<int, 3> result{};
+    lefticus::tools::to_eytzinger(sorted.begin(), sorted.end(), result.begin());
+    return result;
+  }();
+
+  STATIC_REQUIRE(data[lefticus::tools::eytzinger_lower_bound(data, 5)] == 10);// NOLINT Magic Number
+  STATIC_REQUIRE(data[lefticus::tools::eytzinger_lower_bound(data, 25)] == 30);// NOLINT Magic Number
+  STATIC_REQUIRE(lefticus::tools::eytzinger_lower_bound(data, 31) == data.size());// NOLINT Magic Number
+  STATIC_REQUIRE(lefticus::tools::eytzinger_lower_bound(std::array<int, 0>{}, 1) == 0);
+}
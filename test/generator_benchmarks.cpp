@@ -0,0 +1,143 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/generator.hpp>
+#include <lefticus/tools/lambda_coroutines.hpp>
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#if __has_include(<generator>)
+#include <generator>
+#endif
+
+// Many short-lived generators: creation cost dominates, which is where
+// recycling frames matters. Each benchmark creates generator_count
+// generators of value_count values and sums everything they yield.
+
+namespace {
+constexpr int generator_count = 4096;
+constexpr int value_count = 16;
+
+using lefticus::tools::lambda_coroutines::frame_storage;
+using lefticus::tools::lambda_coroutines::generator;
+
+generator<std::uint64_t> cached_values(const std::uint64_t seed)
+{
+  for (std::uint64_t value = seed; value < seed + value_count; ++value) { co_yield value; }
+}
+
+template<typename Storage>
+generator<std::uint64_t> stored_values(std::allocator_arg_t, Storage &, const std::uint64_t seed)
+{
+  for (std::uint64_t value = seed; value < seed + value_count; ++value) { co_yield value; }
+}
+
+auto lambda_values(const std::uint64_t seed)
+{
+  return [state = 0, seed, value = std::uint64_t{}]() mutable -> std::optional<std::uint64_t> {
+    lambda_co_begin(state);
+    for (value = seed; value < seed + value_count; ++value) { lambda_co_yield(value); }
+    lambda_co_return({});
+  };
+}
+
+// the same generator with the default operator new for its frame
+struct heap_generator
+{
+  struct promise_type
+  {
+    std::uint64_t current{};
+    heap_generator get_return_object() { return { std::coroutine_handle<promise_type>::from_promise(*this) }; }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    std::suspend_always yield_value(const std::uint64_t value) noexcept
+    {
+      current = value;
+      return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+
+  heap_generator(std::coroutine_handle<promise_type> handle_) : handle{ handle_ } {}
+  heap_generator(const heap_generator &) = delete;
+  heap_generator &operator=(const heap_generator &) = delete;
+  heap_generator(heap_generator &&) = delete;
+  heap_generator &operator=(heap_generator &&) = delete;
+  ~heap_generator() { handle.destroy(); }
+};
+
+heap_generator heap_values(const std::uint64_t seed)
+{
+  for (std::uint64_t value = seed; value < seed + value_count; ++value) { co_yield value; }
+}
+
+#if defined(__cpp_lib_generator)
+std::generator<std::uint64_t> std_values(const std::uint64_t seed)
+{
+  for (std::uint64_t value = seed; value < seed + value_count; ++value) { co_yield value; }
+}
+#endif
+}// namespace
+
+TEST_CASE("[generator] many short generators", "[!benchmark]")
+{
+  BENCHMARK("lambda coroutine")
+  {
+    std::uint64_t total = 0;
+    for (int index = 0; index < generator_count; ++index) {
+      auto values = lambda_values(static_cast<std::uint64_t>(index));
+      while (const auto value = values()) { total += *value; }
+    }
+    return total;
+  };
+
+  BENCHMARK("generator, frame_cache")
+  {
+    std::uint64_t total = 0;
+    for (int index = 0; index < generator_count; ++index) {
+      for (const auto value : cached_values(static_cast<std::uint64_t>(index))) { total += value; }
+    }
+    return total;
+  };
+
+  auto storage = std::make_unique<frame_storage<256, 1>>();
+  BENCHMARK("generator, frame_storage")
+  {
+    std::uint64_t total = 0;
+    for (int index = 0; index < generator_count; ++index) {
+      for (const auto value : stored_values(std::allocator_arg, *storage, static_cast<std::uint64_t>(index))) {
+        total += value;
+      }
+    }
+    return total;
+  };
+
+  BENCHMARK("C++20 coroutine, operator new")
+  {
+    std::uint64_t total = 0;
+    for (int index = 0; index < generator_count; ++index) {
+      const heap_generator values = heap_values(static_cast<std::uint64_t>(index));
+      for (values.handle.resume(); !values.handle.done(); values.handle.resume()) {
+        total += values.handle.promise().current;
+      }
+    }
+    return total;
+  };
+
+#if defined(__cpp_lib_generator)
+  BENCHMARK("std::generator")
+  {
+    std::uint64_t total = 0;
+    for (int index = 0; index < generator_count; ++index) {
+      for (const auto value : std_values(static_cast<std::uint64_t>(index))) { total += value; }
+    }
+    return total;
+  };
+#endif
+}
@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <lefticus/tools/generator.hpp>
+#include <lefticus/tools/lambda_coroutines.hpp>
+
+using lefticus::tools::lambda_coroutines::frame_cache;
+using lefticus::tools::lambda_coroutines::frame_storage;
+using lefticus::tools::lambda_coroutines::generator;
+
+namespace {
+generator<int> count_to(const int last)
+{
+  for (int value = 1; value <= last; ++value) { co_yield value; }
+}
+
+template<typename Storage> generator<int> count_to(std::allocator_arg_t, Storage &, const int last)
+{
+  for (int value = 1; value <= last; ++value) { co_yield value; }
+}
+
+generator<std::string> words()
+{
+  co_yield "hello";
+  co_yield std::string{ "generator" };
+}
+
+generator<int> fails_after(const int count)
+{
+  for (int value = 0; value < count; ++value) { co_yield value; }
+  throw std::runtime_error("generator failed");
+}
+}// namespace
+
+TEST_CASE("[generator] iterates with range for")
+{
+  std::vector<int> values;
+  for (const auto value : count_to(4)) { values.push_back(value); }
+  CHECK(values == std::vector<int>{ 1, 2, 3, 4 });
+
+  std::vector<std::string> strings;
+  for (const auto &word : words()) { strings.push_back(word); }
+  CHECK(strings == std::vector<std::string>{ "hello", "generator" });
+}
+
+TEST_CASE("[generator] is callable like a lambda coroutine")
+{
+  auto counter = count_to(2);
+  CHECK(counter() == 1);
+  CHECK(counter() == 2);
+  CHECK(!counter());
+  CHECK(!counter());
+
+  int total = 0;
+  for (const auto value : lefticus::tools::lambda_coroutines::while_has_value(count_to(3))) { total += value; }
+  CHECK(total == 6);
+}
+
+TEST_CASE("[generator] rethrows exceptions from the coroutine")
+{
+  auto failing = fails_after(1);
+  CHECK(failing() == 0);
+  CHECK_THROWS_AS(failing(), std::runtime_error);
+}
+
+TEST_CASE("[generator] frames are recycled by the thread's frame_cache")
+{
+  // make sure a frame of this size class is cached
+  { auto warm_up = count_to(1); }
+  const auto cached = frame_cache::local().cached();
+  CHECK(cached > 0);
+
+  {
+    auto counter = count_to(10);
+    CHECK(frame_cache::local().cached() == cached - 1);
+  }
+  CHECK(frame_cache::local().cached() == cached);
+}
+
+TEST_CASE("[generator] frames destroyed on another thread go to that thread's cache")
+{
+  std::optional<generator<int>> counter;
+  std::thread{ [&counter] { counter.emplace(count_to(3)); } }.join();
+
+  // the allocating thread and its cache are gone by now
+  const auto cached = frame_cache::local().cached();
+  CHECK((*counter)() == 1);
+  counter.reset();
+  CHECK(frame_cache::local().cached() == cached + 1);
+}
+
+TEST_CASE("[generator] frames can come from caller-provided storage")
+{
+  frame_storage<256, 1> storage;
+
+  int total = 0;
+  for (int round = 0; round < 3; ++round) {
+    for (const auto value : count_to(std::allocator_arg, storage, 4)) { total += value; }
+  }
+  CHECK(total == 30);
+
+  auto first = count_to(std::allocator_arg, storage, 1);
+  CHECK_THROWS_AS(count_to(std::allocator_arg, storage, 1), std::bad_alloc);
+
+  frame_storage<16, 1> too_small;
+  CHECK_THROWS_AS(count_to(std::allocator_arg, too_small, 1), std::bad_alloc);
+}
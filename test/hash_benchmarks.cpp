@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/hash.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// std::hash against lefticus::tools::hash on the key shapes we actually use:
+// dense ids, ids allocated in pages, short identifier strings and grid
+// coordinates. libstdc++ hashes integers with the identity into prime sized
+// tables, which keeps dense ids in bucket order; expect std::hash to win
+// there. Grid coordinates have no std::hash, so they are compared against
+// the usual `x * 31 + y` combination.
+
+namespace {
+constexpr std::size_t key_count = 1 << 16;
+
+[[nodiscard]] std::uint64_t next_random(std::uint64_t &state)
+{
+  state = state * 6364136223846793005ULL + 1442695040888963407ULL;// NOLINT Magic Number
+  return state >> 16U;// NOLINT Magic Number
+}
+
+[[nodiscard]] std::vector<std::uint64_t> sequential_keys()
+{
+  std::vector<std::uint64_t> keys;
+  for (std::uint64_t key = 0; key < key_count; ++key) { keys.push_back(key); }
+  return keys;
+}
+
+// ids allocated in pages, so the low bits repeat
+[[nodiscard]] std::vector<std::uint64_t> strided_keys()
+{
+  std::vector<std::uint64_t> keys;
+  for (std::uint64_t key = 0; key < key_count; ++key) { keys.push_back(key << 12U); }// NOLINT Magic Number
+  return keys;
+}
+
+[[nodiscard]] std::vector<std::string> identifier_keys()
+{
+  std::vector<std::string> keys;
+  std::uint64_t state = 1;
+  for (std::size_t index = 0; index < key_count; ++index) {
+    keys.push_back("entity_" + std::to_string(next_random(state) % 1000000U));// NOLINT Magic Number
+  }
+  return keys;
+}
+
+using coordinate = std::pair<std::uint32_t, std::uint32_t>;
+
+[[nodiscard]] std::vector<coordinate> grid_keys()
+{
+  std::vector<coordinate> keys;
+  for (std::uint32_t x = 0; x < 256; ++x) {// NOLINT Magic Number
+    for (std::uint32_t y = 0; y < 256; ++y) { keys.emplace_back(x, y); }// NOLINT Magic Number
+  }
+  return keys;
+}
+
+struct combined_coordinate_hash
+{
+  [[nodiscard]] std::size_t operator()(const coordinate &key) const noexcept
+  {
+    return std::hash<std::uint32_t>{}(key.first) * 31U + std::hash<std::uint32_t>{}(key.second);// NOLINT Magic Number
+  }
+};
+
+template<typename Hash, typename Key> [[nodiscard]] std::size_t build_and_probe(const std::vector<Key> &keys)
+{
+  std::unordered_map<Key, std::uint32_t, Hash> map;
+  map.reserve(keys.size());
+  for (const auto &key : keys) { ++map[key]; }
+  std::size_t found = 0;
+  for (const auto &key : keys) { found += map.count(key); }
+  return found;
+}
+
+template<typename Key> void compare(const std::vector<Key> &keys)
+{
+  BENCHMARK("std::hash") { return build_and_probe<std::hash<Key>>(keys); };
+  BENCHMARK("lefticus::tools::hash") { return build_and_probe<lefticus::tools::hash<Key>>(keys); };
+}
+}// namespace
+
+TEST_CASE("[hash] sequential integer keys", "[!benchmark]") { compare(sequential_keys()); }
+
+TEST_CASE("[hash] strided integer keys", "[!benchmark]") { compare(strided_keys()); }
+
+TEST_CASE("[hash] identifier string keys", "[!benchmark]") { compare(identifier_keys()); }
+
+TEST_CASE("[hash] grid coordinate keys", "[!benchmark]")
+{
+  const auto keys = grid_keys();
+  BENCHMARK("x * 31 + y") { return build_and_probe<combined_coordinate_hash>(keys); };
+  BENCHMARK("lefticus::tools::hash") { return build_and_probe<lefticus::tools::hash<coordinate>>(keys); };
+}
+
+TEST_CASE("[hash] raw throughput", "[!benchmark]")
+{
+  const auto keys = identifier_keys();
+  BENCHMARK("std::hash<std::string>")
+  {
+    std::size_t total = 0;
+    for (const auto &key : keys) { total += std::hash<std::string>{}(key); }
+    return total;
+  };
+  BENCHMARK("lefticus::tools::hash<std::string>")
+  {
+    std::size_t total = 0;
+    for (const auto &key : keys) { total += lefticus::tools::hash<std::string>{}(key); }
+    return total;
+  };
+}
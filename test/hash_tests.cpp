@@ -0,0 +1,95 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/hash.hpp>
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+using lefticus::tools::hash_value;
+
+using EntityKey = lefticus::tools::strong_alias<std::uint32_t, struct EntityKeyTag>;
+auto equate(EntityKey, EntityKey) -> bool;
+
+TEST_CASE("hash_value is usable at compile time")
+{
+  STATIC_REQUIRE(hash_value(42) == hash_value(42));// NOLINT Magic Number
+  STATIC_REQUIRE(hash_value(42) != hash_value(43));// NOLINT Magic Number
+  STATIC_REQUIRE(hash_value(1, 1) != hash_value(1, 2));
+  STATIC_REQUIRE(hash_value(std::string_view{ "hello" }) != hash_value(std::string_view{ "hellp" }));
+  STATIC_REQUIRE(hash_value(std::string_view{}) != hash_value(std::string_view{ "", 1 }));
+  STATIC_REQUIRE(hash_value(0.0) == hash_value(-0.0));
+  STATIC_REQUIRE(hash_value(true) != hash_value(false));
+}
+
+TEST_CASE("hash_value agrees across library types")
+{
+  using namespace lefticus::tools::literals;
+  using lefticus::tools::int_np;
+
+  STATIC_REQUIRE(hash_value(EntityKey{ 7U }) == hash_value(std::uint32_t{ 7 }));// NOLINT Magic Number
+  STATIC_REQUIRE(hash_value(int_np<std::uint32_t>{ 7U }) == hash_value(std::uint32_t{ 7 }));// NOLINT Magic Number
+  STATIC_REQUIRE(hash_value(lefticus::tools::int_sat<std::uint32_t>{ 7U }) == hash_value(int_np<std::uint32_t>{ 7U }));
+
+  CONSTEXPR lefticus::tools::simple_stack_string<32> stack_string{ std::string_view{ "identifier" } };
+  STATIC_REQUIRE(hash_value(stack_string) == hash_value(std::string_view{ "identifier" }));
+  CHECK(hash_value(std::string{ "identifier" }) == hash_value(stack_string));
+
+  STATIC_REQUIRE(
+    hash_value(std::pair{ 1, std::string_view{ "a" } }) != hash_value(std::pair{ 2, std::string_view{ "a" } }));
+  STATIC_REQUIRE(hash_value(std::pair{ 1, 2 }) != hash_value(std::pair{ 2, 1 }));
+  STATIC_REQUIRE(hash_value(lefticus::tools::pair{ 1, 2 }) == hash_value(std::pair{ 1, 2 }));
+}
+
+TEST_CASE("hash_value covers every length")
+{
+  // each length takes one of the short, medium or bulk paths, and a
+  // single flipped byte anywhere must change the result
+  std::string text(200, 'x');// NOLINT Magic Number
+  std::set<std::uint64_t> seen;
+  for (std::size_t length = 0; length <= text.size(); ++length) {
+    const std::string_view prefix{ text.data(), length };
+    const auto original = hash_value(prefix);
+    CHECK(seen.insert(original).second);
+    for (std::size_t position = 0; position < length; ++position) {
+      text[position] = 'y';
+      CHECK(hash_value(prefix) != original);
+      text[position] = 'x';
+    }
+  }
+}
+
+TEST_CASE("library types work as hashed container keys")
+{
+  std::unordered_map<EntityKey, std::string> names;
+  names[EntityKey{ 1U }] = "first";
+  names[EntityKey{ 2U }] = "second";
+  CHECK(names.at(EntityKey{ 2U }) == "second");
+
+  std::unordered_set<lefticus::tools::int_np<std::int32_t>> numbers{ -1, 0, 1 };
+  CHECK(numbers.contains(0));
+
+  std::unordered_set<lefticus::tools::simple_stack_string<16>> words;
+  words.emplace(std::string_view{ "word" });
+  CHECK(words.contains(lefticus::tools::simple_stack_string<16>{ std::string_view{ "word" } }));
+
+  std::unordered_map<std::pair<int, int>, int, lefticus::tools::hash<std::pair<int, int>>> grid;
+  grid[{ 1, 2 }] = 3;
+  CHECK(grid.at({ 1, 2 }) == 3);
+
+  // the value type of simple_stack_flat_map
+  std::unordered_set<lefticus::tools::pair<int, EntityKey>> entries;
+  entries.insert(lefticus::tools::pair{ 1, EntityKey{ 2U } });
+  CHECK(entries.contains(lefticus::tools::pair{ 1, EntityKey{ 2U } }));
+  CHECK(!entries.contains(lefticus::tools::pair{ 2, EntityKey{ 1U } }));
+}
@@ -0,0 +1,57 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/lambda_coroutines.hpp>
+
+#include <cstdint>
+#include <ranges>
+
+// Summing the values of a lambda coroutine one at a time through the range
+// iterator, through a std::views pipeline, and in chunks. When the lambda
+// inlines, the iterator already compiles to the hand-written loop and the
+// chunk copy is pure overhead; chunks pay off when the consumer vectorises.
+
+namespace {
+constexpr std::size_t value_count = 1 << 16;
+
+// a pseudo random sequence from a run time seed, so the sums cannot be folded at compile time
+auto sequence()
+{
+  static volatile std::uint32_t seed = 1;
+  return [state = 0, value = std::uint32_t{ seed }]() mutable {
+    lambda_co_begin(state);
+    while (true) {
+      value = value * 1664525U + 1013904223U;// NOLINT Magic Number
+      lambda_co_yield(value >> 8U);// NOLINT Magic Number
+    }
+    lambda_co_end();
+  };
+}
+}// namespace
+
+TEST_CASE("[lambda_coroutines] range iteration", "[!benchmark]")
+{
+  BENCHMARK("iterator")
+  {
+    std::uint64_t total = 0;
+    for (const auto value : lefticus::tools::lambda_coroutines::range(sequence(), 0, value_count)) { total += value; }
+    return total;
+  };
+
+  BENCHMARK("std::views::transform")
+  {
+    std::uint64_t total = 0;
+    for (const auto value : lefticus::tools::lambda_coroutines::range(sequence(), 0, value_count)
+                              | std::views::transform([](const std::uint32_t value) { return value * 3U; })) {
+      total += value;
+    }
+    return total;
+  };
+
+  BENCHMARK("chunk<64>")
+  {
+    std::uint64_t total = 0;
+    for (const auto &batch : lefticus::tools::lambda_coroutines::range(sequence(), 0, value_count).chunk<64>()) {
+      for (const auto value : batch) { total += value; }
+    }
+    return total;
+  };
+}
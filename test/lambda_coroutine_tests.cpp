@@ -2,6 +2,9 @@
 #include <catch2/catch.hpp>
 #include <lefticus/tools/lambda_coroutines.hpp>
 
+#include <iterator>
+#include <ranges>
+
 #ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
 #define CONSTEXPR
 #else
@@ -46,3 +49,81 @@ TEST_CASE("[lambda_coroutines] is constexpr capable") { STATIC_REQUIRE(get_first
 #else
 #pragma message("Visual Studio's constexpr engine is not capable of handling the lambda coroutines")
 #endif
+
+namespace {
+constexpr auto counter()
+{
+  return [state = 0, value = 0]() mutable {
+    lambda_co_begin(state);
+    while (true) { lambda_co_yield(value++); }
+    lambda_co_end();
+  };
+}
+}// namespace
+
+TEST_CASE("[lambda_coroutines] range is a std::ranges::input_range")
+{
+  using counter_range = decltype(lefticus::tools::lambda_coroutines::range(counter()));
+  STATIC_REQUIRE(std::ranges::input_range<counter_range>);
+  STATIC_REQUIRE(std::ranges::viewable_range<counter_range>);
+  STATIC_REQUIRE(std::input_iterator<std::ranges::iterator_t<counter_range>>);
+
+  STATIC_REQUIRE([] {
+    auto values = lefticus::tools::lambda_coroutines::range(counter(), 2, 6, 2);
+    std::array<int, 3> result{};
+    std::size_t count = 0;
+    for (const auto value : values) { result.at(count++) = value; }
+    return count == 3 && result == std::array{ 2, 4, 6 };
+  }());
+}
+
+TEST_CASE("[lambda_coroutines] range dereference has no side effects")
+{
+  STATIC_REQUIRE([] {
+    auto values = lefticus::tools::lambda_coroutines::range(counter());
+    auto itr = values.begin();
+    const bool stable = *itr == 0 && *itr == 0;
+    ++itr;
+    return stable && *itr == 1;
+  }());
+}
+
+TEST_CASE("[lambda_coroutines] range feeds std::views")
+{
+  STATIC_REQUIRE([] {
+    int total = 0;
+    for (const auto value : lefticus::tools::lambda_coroutines::range(counter())
+                              | std::views::filter([](const int value) { return value % 3 == 0; })
+                              | std::views::take(4)) {
+      total += value;
+    }
+    return total;
+  }() == 0 + 3 + 6 + 9);
+}
+
+TEST_CASE("[lambda_coroutines] range pulls values in chunks")
+{
+  STATIC_REQUIRE([] {
+    std::size_t batches = 0;
+    int total = 0;
+    std::size_t last_size = 0;
+    for (const auto &batch : lefticus::tools::lambda_coroutines::range(counter(), 0, 10).chunk<4>()) {
+      ++batches;
+      last_size = batch.size();
+      for (const auto value : batch) { total += value; }
+    }
+    return batches == 3 && last_size == 2 && total == 45;
+  }());
+
+  STATIC_REQUIRE([] {
+    // chunks borrowed from a range continue where it left off
+    auto values = lefticus::tools::lambda_coroutines::range(counter(), 0, 5);
+    auto itr = values.begin();
+    ++itr;
+    int total = 0;
+    for (const auto &batch : values.chunk<8>()) {
+      for (const auto value : batch) { total += value; }
+    }
+    return total;
+  }() == 1 + 2 + 3 + 4);
+}
@@ -0,0 +1,131 @@
+#include <catch2/catch.hpp>
+
+#include <lefticus/tools/lambda_io.hpp>
+
+#include <array>
+#include <cerrno>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace lefticus::tools::lambda_coroutines;
+
+// Echo conversations over socketpairs, each client sending `rounds` bytes and
+// waiting for every one to come back. The same work is done by lambda
+// coroutines on one thread, with each I/O backend, and by a thread per end.
+namespace {
+constexpr std::size_t conversations = 64;
+constexpr int rounds = 16;
+
+using driver = io_driver<conversations * 2>;
+
+struct socket_pairs
+{
+  std::array<std::array<int, 2>, conversations> fds{};
+
+  explicit socket_pairs(const int flags)
+  {
+    for (auto &pair : fds) { REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | flags, 0, pair.data()) == 0); }
+  }
+  socket_pairs(const socket_pairs &) = delete;
+  socket_pairs &operator=(const socket_pairs &) = delete;
+  ~socket_pairs()
+  {
+    for (const auto &pair : fds) {
+      ::close(pair[0]);
+      ::close(pair[1]);
+    }
+  }
+};
+
+struct echo_end
+{
+  driver *io = nullptr;
+  int fd = -1;
+  bool client = false;
+  int *echoed = nullptr;
+
+  io_handle handle{};
+  int round = 0;
+  char byte = 0;
+  ssize_t result = 0;
+  int state = 0;
+
+  task_step operator()()
+  {
+    lambda_co_begin(state);
+    handle = io->watch(fd);
+    if (client) {
+      for (round = 0; round < rounds; ++round) {
+        byte = static_cast<char>(round);
+        ::write(fd, &byte, 1);
+        while (::read(fd, &byte, 1) != 1) { lambda_co_yield(io->wait(handle, io_interest::read)); }
+        ++*echoed;
+      }
+      ::shutdown(fd, SHUT_WR);
+    } else {
+      while ((result = ::read(fd, &byte, 1)) != 0) {
+        if (result == 1) {
+          ::write(fd, &byte, 1);
+        } else {
+          lambda_co_yield(io->wait(handle, io_interest::read));
+        }
+      }
+    }
+    io->unwatch(handle);
+    lambda_co_return(task_step::done());
+  }
+};
+
+int run_tasks(const io_backend backend)
+{
+  const socket_pairs pairs{ SOCK_NONBLOCK };
+  driver io{ backend };
+  int echoed = 0;
+  scheduler<echo_end, conversations * 2> tasks;
+  for (const auto &pair : pairs.fds) {
+    tasks.spawn(echo_end{ &io, pair[0], false, &echoed });
+    tasks.spawn(echo_end{ &io, pair[1], true, &echoed });
+  }
+  io.run(tasks);
+  return echoed;
+}
+
+int run_threads()
+{
+  const socket_pairs pairs{ 0 };
+  std::array<int, conversations> echoed{};
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t index = 0; index < conversations; ++index) {
+      threads.emplace_back([fd = pairs.fds[index][0]] {
+        char byte = 0;
+        while (::read(fd, &byte, 1) == 1) { ::write(fd, &byte, 1); }
+      });
+      threads.emplace_back([fd = pairs.fds[index][1], &count = echoed[index]] {
+        char byte = 0;
+        for (int round = 0; round < rounds; ++round) {
+          byte = static_cast<char>(round);
+          ::write(fd, &byte, 1);
+          if (::read(fd, &byte, 1) == 1) { ++count; }
+        }
+        ::shutdown(fd, SHUT_WR);
+      });
+    }
+  }
+  int total = 0;
+  for (const auto count : echoed) { total += count; }
+  return total;
+}
+}// namespace
+
+TEST_CASE("[io_driver] echo conversations", "[!benchmark]")
+{
+  BENCHMARK("lambda coroutines on epoll") { return run_tasks(io_backend::epoll); };
+  if (driver::io_uring_supported()) {
+    BENCHMARK("lambda coroutines on io_uring") { return run_tasks(io_backend::io_uring); };
+  }
+  BENCHMARK("thread per connection") { return run_threads(); };
+}
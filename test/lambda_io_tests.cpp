@@ -0,0 +1,234 @@
+#include <catch2/catch.hpp>
+
+#include <lefticus/tools/lambda_io.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace lefticus::tools::lambda_coroutines;
+
+namespace {
+// both ends of a non-blocking pipe or socketpair, closed on destruction
+struct fd_pair
+{
+  std::array<int, 2> fds{ -1, -1 };
+
+  [[nodiscard]] static fd_pair pipe()
+  {
+    fd_pair result;
+    REQUIRE(::pipe2(result.fds.data(), O_NONBLOCK | O_CLOEXEC) == 0);
+    return result;
+  }
+
+  [[nodiscard]] static fd_pair sockets()
+  {
+    fd_pair result;
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, result.fds.data()) == 0);
+    return result;
+  }
+
+  fd_pair() = default;
+  fd_pair(fd_pair &&other) noexcept : fds{ std::exchange(other.fds, { -1, -1 }) } {}
+  fd_pair(const fd_pair &) = delete;
+  fd_pair &operator=(fd_pair &&) = delete;
+  fd_pair &operator=(const fd_pair &) = delete;
+
+  ~fd_pair()
+  {
+    for (const auto fd : fds) {
+      if (fd != -1) { ::close(fd); }
+    }
+  }
+};
+
+std::vector<io_backend> backends()
+{
+  std::vector<io_backend> result{ io_backend::epoll };
+  if (io_driver<1>::io_uring_supported()) { result.push_back(io_backend::io_uring); }
+  return result;
+}
+
+using driver = io_driver<32>;
+
+// one end of an echo conversation: clients send `rounds` bytes one at a time
+// and expect each back, servers echo until the client hangs up
+struct connection
+{
+  driver *io = nullptr;
+  int fd = -1;
+  bool client = false;
+  int rounds = 0;
+  int *echoed = nullptr;
+
+  io_handle handle{};
+  int round = 0;
+  char byte = 0;
+  ssize_t result = 0;
+  int state = 0;
+
+  task_step operator()()
+  {
+    lambda_co_begin(state);
+    handle = io->watch(fd);
+
+    if (client) {
+      for (round = 0; round < rounds; ++round) {
+        byte = static_cast<char>('a' + round);
+        REQUIRE(::write(fd, &byte, 1) == 1);
+        while (::read(fd, &byte, 1) != 1) {
+          REQUIRE(errno == EAGAIN);
+          lambda_co_yield(io->wait(handle, io_interest::read));
+        }
+        if (byte == static_cast<char>('a' + round)) { ++*echoed; }
+      }
+      ::shutdown(fd, SHUT_WR);
+    } else {
+      while (true) {
+        result = ::read(fd, &byte, 1);
+        if (result == 0) { break; }
+        if (result == -1) {
+          REQUIRE(errno == EAGAIN);
+          lambda_co_yield(io->wait(handle, io_interest::read));
+        } else {
+          REQUIRE(::write(fd, &byte, 1) == 1);
+        }
+      }
+    }
+
+    io->unwatch(handle);
+    lambda_co_return(task_step::done());
+  }
+};
+}// namespace
+
+TEST_CASE("[io_driver] wakes a reader when a pipe becomes readable")
+{
+  for (const auto backend : backends()) {
+    const auto pipe = fd_pair::pipe();
+    driver io{ backend };
+    REQUIRE(io.backend() == backend);
+
+    char received = 0;
+    auto reader = [&, handle = io_handle{}, state = 0]() mutable {
+      lambda_co_begin(state);
+      handle = io.watch(pipe.fds[0]);
+      while (::read(pipe.fds[0], &received, 1) != 1) { lambda_co_yield(io.wait(handle, io_interest::read)); }
+      io.unwatch(handle);
+      lambda_co_return(task_step::done());
+    };
+
+    scheduler<decltype(reader), 1> tasks;
+    tasks.spawn(reader);
+    tasks.run();
+    REQUIRE(io.waiting() == 1);
+    REQUIRE(io.poll(tasks, 0) == 0);
+
+    const char sent = 'x';
+    REQUIRE(::write(pipe.fds[1], &sent, 1) == 1);
+    REQUIRE(io.poll(tasks, 1000) == 1);// NOLINT Magic Number
+    tasks.run();
+
+    CHECK(received == 'x');
+    CHECK(tasks.empty());
+    CHECK(io.waiting() == 0);
+  }
+}
+
+TEST_CASE("[io_driver] wakes a writer when a full pipe drains")
+{
+  for (const auto backend : backends()) {
+    const auto pipe = fd_pair::pipe();
+    driver io{ backend };
+
+    const std::array<char, 4096> block{};// NOLINT Magic Number
+    while (::write(pipe.fds[1], block.data(), block.size()) > 0) {}
+    REQUIRE(errno == EAGAIN);
+
+    bool wrote = false;
+    auto writer = [&, handle = io_handle{}, state = 0]() mutable {
+      lambda_co_begin(state);
+      handle = io.watch(pipe.fds[1]);
+      while (::write(pipe.fds[1], block.data(), 1) != 1) { lambda_co_yield(io.wait(handle, io_interest::write)); }
+      wrote = true;
+      io.unwatch(handle);
+      lambda_co_return(task_step::done());
+    };
+
+    scheduler<decltype(writer), 1> tasks;
+    tasks.spawn(writer);
+    tasks.run();
+    REQUIRE(!wrote);
+    REQUIRE(io.poll(tasks, 0) == 0);
+
+    std::array<char, 4096> drain{};// NOLINT Magic Number
+    while (::read(pipe.fds[0], drain.data(), drain.size()) > 0) {}
+    io.run(tasks);
+
+    CHECK(wrote);
+    CHECK(tasks.empty());
+  }
+}
+
+TEST_CASE("[io_driver] serves many socketpair connections from one thread")
+{
+  constexpr int connections = 12;
+  constexpr int rounds = 5;
+
+  for (const auto backend : backends()) {
+    driver io{ backend };
+    std::vector<fd_pair> pairs;
+    int echoed = 0;
+
+    scheduler<connection, connections * 2> tasks;
+    for (int index = 0; index < connections; ++index) {
+      auto &sockets = pairs.emplace_back(fd_pair::sockets());
+      tasks.spawn(connection{ &io, sockets.fds[0], false, 0, &echoed });
+      tasks.spawn(connection{ &io, sockets.fds[1], true, rounds, &echoed });
+    }
+
+    io.run(tasks);
+
+    CHECK(echoed == connections * rounds);
+    CHECK(tasks.empty());
+    CHECK(io.waiting() == 0);
+  }
+}
+
+TEST_CASE("[io_driver] rejects misuse")
+{
+  const auto pipe = fd_pair::pipe();
+  io_driver<1> io;
+
+  io_handle handle{};
+  auto reader = [&, state = 0]() mutable {
+    lambda_co_begin(state);
+    handle = io.watch(pipe.fds[0]);
+    lambda_co_yield(io.wait(handle, io_interest::read));
+    lambda_co_return(task_step::done());
+  };
+  scheduler<decltype(reader), 1> tasks;
+  tasks.spawn(reader);
+  tasks.run();
+
+  CHECK_THROWS_AS(io.watch(pipe.fds[1]), std::length_error);
+  CHECK_THROWS_AS(io.unwatch(handle), std::logic_error);
+
+  const char sent = 'x';
+  REQUIRE(::write(pipe.fds[1], &sent, 1) == 1);
+  io.run(tasks);
+  REQUIRE(tasks.empty());
+
+  io.unwatch(handle);
+  CHECK_THROWS_AS(io.wait(handle, io_interest::read), std::invalid_argument);
+  CHECK_THROWS_AS(io.unwatch(handle), std::invalid_argument);
+  CHECK_THROWS_AS(io.watch(-1), std::system_error);
+}
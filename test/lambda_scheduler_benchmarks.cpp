@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/lambda_scheduler.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// The cost of switching between many small tasks: lambda coroutines on a
+// scheduler, C++20 coroutines resumed round-robin, and two threads handing
+// control back and forth. Every benchmark performs switch_count switches,
+// so the results divide directly into a per-switch cost.
+
+namespace {
+constexpr std::size_t device_count = 10000;
+constexpr std::size_t switch_count = 1 << 15;
+
+using lefticus::tools::lambda_coroutines::task_step;
+
+auto make_device(std::uint64_t &ticks)
+{
+  return [state = 0, &ticks]() mutable {
+    lambda_co_begin(state);
+    while (true) {
+      ++ticks;
+      lambda_co_yield(task_step::yield());
+    }
+    lambda_co_return(task_step::done());
+  };
+}
+
+using device_scheduler =
+  lefticus::tools::lambda_coroutines::scheduler<decltype(make_device(std::declval<std::uint64_t &>())), device_count>;
+
+// the least a C++20 coroutine needs to be resumable by hand
+struct device_coroutine
+{
+  struct promise_type
+  {
+    device_coroutine get_return_object() { return { std::coroutine_handle<promise_type>::from_promise(*this) }; }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+device_coroutine run_device(std::uint64_t &ticks)
+{
+  while (true) {
+    ++ticks;
+    co_await std::suspend_always{};
+  }
+}
+}// namespace
+
+TEST_CASE("[lambda_scheduler] context switch", "[!benchmark]")
+{
+  std::uint64_t lambda_ticks = 0;
+  // 10000 slots are too large for the stack
+  auto scheduler = std::make_unique<device_scheduler>();
+  for (std::size_t index = 0; index < device_count; ++index) { scheduler->spawn(make_device(lambda_ticks)); }
+
+  BENCHMARK("lambda coroutine scheduler") { return scheduler->run(switch_count); };
+
+  std::uint64_t coroutine_ticks = 0;
+  std::vector<std::coroutine_handle<>> coroutines;
+  for (std::size_t index = 0; index < device_count; ++index) {
+    coroutines.push_back(run_device(coroutine_ticks).handle);
+  }
+  std::size_t next = 0;
+
+  BENCHMARK("C++20 coroutines")
+  {
+    for (std::size_t step = 0; step < switch_count; ++step) {
+      coroutines[next].resume();
+      next = next + 1 == coroutines.size() ? 0 : next + 1;
+    }
+    return coroutine_ticks;
+  };
+
+  for (const auto coroutine : coroutines) { coroutine.destroy(); }
+
+  BENCHMARK("threads")
+  {
+    // each hand-off wakes the other thread, which is one switch
+    std::atomic<std::size_t> turn{ 0 };
+    const auto take_turn = [&turn](const std::size_t step) {
+      for (auto current = turn.load(); current != step; current = turn.load()) { turn.wait(current); }
+      turn.store(step + 1);
+      turn.notify_one();
+    };
+    std::thread other([&take_turn] {
+      for (std::size_t step = 1; step < switch_count; step += 2) { take_turn(step); }
+    });
+    for (std::size_t step = 0; step < switch_count; step += 2) { take_turn(step); }
+    other.join();
+    return turn.load();
+  };
+}
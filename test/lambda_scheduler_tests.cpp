@@ -0,0 +1,150 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/lambda_scheduler.hpp>
+
+#include <array>
+#include <stdexcept>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+using lefticus::tools::lambda_coroutines::scheduler;
+using lefticus::tools::lambda_coroutines::task_step;
+using lefticus::tools::lambda_coroutines::wait_queue;
+
+namespace {
+// records which task ran, in order
+struct trace
+{
+  std::array<int, 16> order{};
+  std::size_t length = 0;
+
+  constexpr void record(const int task) { order.at(length++) = task; }
+};
+
+constexpr auto make_counter(trace &log, const int name, const int steps)
+{
+  return [state = 0, &log, name, steps, step = 0]() mutable {
+    lambda_co_begin(state);
+    for (step = 0; step < steps; ++step) {
+      log.record(name);
+      lambda_co_yield(task_step::yield());
+    }
+    lambda_co_return(task_step::done());
+  };
+}
+}// namespace
+
+TEST_CASE("scheduler runs ready tasks round-robin")
+{
+  STATIC_REQUIRE([] {
+    trace log;
+    scheduler<decltype(make_counter(log, 0, 0)), 4> tasks;
+    tasks.spawn(make_counter(log, 1, 2));
+    tasks.spawn(make_counter(log, 2, 3));
+    tasks.spawn(make_counter(log, 3, 1));
+    const auto steps = tasks.run();
+
+    const std::array<int, 6> expected{ 1, 2, 3, 1, 2, 2 };
+    for (std::size_t index = 0; index < expected.size(); ++index) {
+      if (log.order[index] != expected[index]) { return false; }
+    }
+    // each task takes one extra resume to return done
+    return steps == 9 && log.length == 6 && tasks.empty();
+  }());
+}
+
+TEST_CASE("scheduler prefers lower priority levels")
+{
+  STATIC_REQUIRE([] {
+    trace log;
+    scheduler<decltype(make_counter(log, 0, 0)), 4, 2> tasks;
+    tasks.spawn(make_counter(log, 1, 2), 1);
+    tasks.spawn(make_counter(log, 2, 2), 0);
+    tasks.run();
+    return log.order[0] == 2 && log.order[1] == 2 && log.order[2] == 1 && log.order[3] == 1;
+  }());
+}
+
+TEST_CASE("scheduler wakes waiting tasks on notify")
+{
+  STATIC_REQUIRE([] {
+    wait_queue data_ready;
+    int received = 0;
+    int sent = 0;
+
+    auto consumer = [state = 0, &data_ready, &received, &sent]() mutable {
+      lambda_co_begin(state);
+      while (received < 3) {
+        while (received == sent) { lambda_co_yield(task_step::wait(data_ready)); }
+        ++received;
+      }
+      lambda_co_return(task_step::done());
+    };
+
+    scheduler<decltype(consumer), 2> tasks;
+    const auto id = tasks.spawn(consumer);
+
+    // nothing to do until notified
+    tasks.run();
+    if (received != 0 || tasks.has_ready() || !tasks.running(id)) { return false; }
+
+    for (int value = 0; value < 3; ++value) {
+      ++sent;
+      if (!tasks.notify_one(data_ready)) { return false; }
+      tasks.run();
+    }
+    return received == 3 && !tasks.running(id) && data_ready.empty();
+  }());
+}
+
+TEST_CASE("scheduler tasks can spawn through the scheduler")
+{
+  struct node
+  {
+    int depth = 0;
+    int *count = nullptr;
+    int state = 0;
+
+    constexpr task_step operator()(scheduler<node, 8> &tasks)
+    {
+      lambda_co_begin(state);
+      ++*count;
+      if (depth < 2) {
+        tasks.spawn(node{ depth + 1, count });
+        tasks.spawn(node{ depth + 1, count });
+      }
+      lambda_co_return(task_step::done());
+    }
+  };
+
+  STATIC_REQUIRE([] {
+    int count = 0;
+    scheduler<node, 8> tasks;
+    tasks.spawn(node{ 0, &count });
+    tasks.run();
+    return count;
+  }() == 7);
+}
+
+TEST_CASE("scheduler reuses finished slots")
+{
+  STATIC_REQUIRE([] {
+    trace log;
+    scheduler<decltype(make_counter(log, 0, 0)), 1> tasks;
+    const auto first = tasks.spawn(make_counter(log, 1, 1));
+    tasks.run();
+    const auto second = tasks.spawn(make_counter(log, 2, 1));
+    return first.index == second.index && !tasks.running(first) && tasks.running(second);
+  }());
+
+  trace log;
+  scheduler<decltype(make_counter(log, 0, 0)), 1, 2> tasks;
+  tasks.spawn(make_counter(log, 1, 1));
+  CHECK_THROWS_AS(tasks.spawn(make_counter(log, 2, 1)), std::length_error);
+  CHECK(tasks.run_one());
+  CHECK_THROWS_AS(tasks.spawn(make_counter(log, 2, 1), 2), std::out_of_range);
+}
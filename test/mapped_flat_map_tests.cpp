@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+
+#include <lefticus/tools/flat_map.hpp>
+#include <lefticus/tools/mapped_flat_map.hpp>
+
+
+namespace {
+struct temp_file
+{
+  std::filesystem::path path;
+
+  explicit temp_file(const std::string &name) : path{ std::filesystem::temp_directory_path() / name } {}
+  temp_file(const temp_file &) = delete;
+  temp_file &operator=(const temp_file &) = delete;
+  temp_file(temp_file &&) = delete;
+  temp_file &operator=(temp_file &&) = delete;
+
+  ~temp_file()
+  {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+  }
+};
+
+lefticus::tools::flat_map<std::uint32_t, double> make_source()
+{
+  lefticus::tools::flat_map<std::uint32_t, double> map;
+  // intentionally not inserted in order
+  for (std::uint32_t key = 0; key < 1000; ++key) {// NOLINT Magic Number
+    const auto scrambled = (key * 7919U) % 1000U;// NOLINT Magic Number
+    map[scrambled] = scrambled * 0.5;// NOLINT Magic Number
+  }
+  return map;
+}
+}// namespace
+
+
+TEST_CASE("[mapped_flat_map] round trips a flat_map in sorted layout")// NOLINT (cognitive complexity)
+{
+  const temp_file file{ "lefticus_tools_mapped_flat_map_sorted.bin" };
+  const auto source = make_source();
+
+  lefticus::tools::write_mapped_flat_map(file.path, source);
+
+  const lefticus::tools::mapped_flat_map<std::uint32_t, double> map{ file.path,
+    lefticus::tools::mapped_access::random };
+
+  REQUIRE(map.layout() == lefticus::tools::mapped_layout::sorted);
+  REQUIRE(map.size() == source.size());
+  REQUIRE(std::is_sorted(
+    map.begin(), map.end(), [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; }));
+
+  for (const auto &[key, value] : source) { REQUIRE(map.at(key) == value); }
+
+  REQUIRE(!map.contains(1000U));// NOLINT Magic Number
+  REQUIRE_THROWS_AS(map.at(1000U), std::out_of_range);// NOLINT Magic Number
+}
+
+TEST_CASE("[mapped_flat_map] round trips a flat_map in eytzinger layout")// NOLINT (cognitive complexity)
+{
+  const temp_file file{ "lefticus_tools_mapped_flat_map_eytzinger.bin" };
+  const auto source = make_source();
+
+  lefticus::tools::write_mapped_flat_map(file.path, source, lefticus::tools::mapped_layout::eytzinger);
+
+  const lefticus::tools::mapped_flat_map<std::uint32_t, double> map{ file.path };
+
+  REQUIRE(map.layout() == lefticus::tools::mapped_layout::eytzinger);
+  REQUIRE(map.size() == source.size());
+
+  for (const auto &[key, value] : source) { REQUIRE(map.at(key) == value); }
+
+  REQUIRE(map.find(1000U) == map.end());// NOLINT Magic Number
+}
+
+TEST_CASE("[mapped_flat_map] empty maps are valid")
+{
+  const temp_file file{ "lefticus_tools_mapped_flat_map_empty.bin" };
+
+  lefticus::tools::write_mapped_flat_map(file.path, lefticus::tools::flat_map<int, int>{});
+
+  const lefticus::tools::mapped_flat_map<int, int> map{ file.path };
+  REQUIRE(map.empty());
+  REQUIRE(map.find(1) == map.end());
+}
+
+TEST_CASE("[mapped_flat_map] rejects mismatched record types")
+{
+  const temp_file file{ "lefticus_tools_mapped_flat_map_mismatch.bin" };
+
+  lefticus::tools::write_mapped_flat_map(file.path, lefticus::tools::flat_map<int, int>{ { 1, 2 } });
+
+  using wrong_map = lefticus::tools::mapped_flat_map<std::uint64_t, std::uint64_t>;
+  REQUIRE_THROWS_AS(wrong_map{ file.path }, std::runtime_error);
+}
+
+TEST_CASE("[mapped_flat_map] missing files throw")
+{
+  using map = lefticus::tools::mapped_flat_map<int, int>;
+  REQUIRE_THROWS_AS(map{ "/this/file/does/not/exist" }, std::system_error);
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/memoize.hpp>
+
+#include <tuple>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+namespace {
+constexpr int add(int lhs, int rhs) { return lhs + rhs; }
+}// namespace
+
+TEST_CASE("[memoize] returns the function's results")
+{
+  STATIC_REQUIRE([] {
+    auto cached = lefticus::tools::memoize<4>(add);
+    return cached(1, 2) == 3 && cached(1, 2) == 3 && cached(2, 2) == 4 && cached.size() == 2;
+  }());
+}
+
+TEST_CASE("[memoize] calls the function once per distinct arguments")
+{
+  STATIC_REQUIRE([] {
+    int calls = 0;
+    auto cached = lefticus::tools::memoize<4>([&calls](int value) {
+      ++calls;
+      return value * 2;
+    });
+    for (int round = 0; round < 3; ++round) {
+      for (int value = 0; value < 4; ++value) {
+        if (cached(value) != value * 2) { return false; }
+      }
+    }
+    return calls == 4;
+  }());
+}
+
+TEST_CASE("[memoize] evicts the least recently used result")
+{
+  STATIC_REQUIRE([] {
+    auto cached = lefticus::tools::memoize<2>(add);
+    std::ignore = cached(1, 1);
+    std::ignore = cached(2, 2);
+    // touching 1 + 1 leaves 2 + 2 as the oldest
+    std::ignore = cached(1, 1);
+    std::ignore = cached(3, 3);
+    return cached.size() == 2 && cached.contains(1, 1) && !cached.contains(2, 2) && cached.contains(3, 3);
+  }());
+}
+
+TEST_CASE("[memoize] generic callables name their argument types")
+{
+  STATIC_REQUIRE([] {
+    lefticus::tools::memoized<decltype([](auto lhs, auto rhs) { return lhs * rhs; }), 2, int, long> cached{ {} };
+    return cached(3, 4L) == 12L;
+  }());
+}
@@ -0,0 +1,94 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/non_promoting_endian.hpp>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+namespace {
+struct wire_header
+{
+  lefticus::tools::big_np<std::uint16_t> type;
+  lefticus::tools::big_np<std::uint32_t> length;
+  lefticus::tools::little_np<std::int16_t> offset;
+};
+
+constexpr std::array<unsigned char, 8> raw_header{ 0x12, 0x34, 0x00, 0x01, 0x02, 0x03, 0xFE, 0xFF };// NOLINT
+}// namespace
+
+TEST_CASE("[endian_np] storage is byte aligned and tightly packed")
+{
+  STATIC_REQUIRE(sizeof(wire_header) == 8);// NOLINT Magic Number
+  STATIC_REQUIRE(alignof(wire_header) == 1);
+  STATIC_REQUIRE(std::is_trivially_copyable_v<wire_header>);
+}
+
+TEST_CASE("[endian_np] overlay on raw bytes")
+{
+  CONSTEXPR const auto header = std::bit_cast<wire_header>(raw_header);
+
+  STATIC_REQUIRE(header.type.get() == 0x1234);// NOLINT Magic Number
+  STATIC_REQUIRE(header.length.get() == 0x00010203);// NOLINT Magic Number
+  STATIC_REQUIRE(header.offset.get() == -2);// NOLINT Magic Number
+  STATIC_REQUIRE(std::bit_cast<std::array<unsigned char, 8>>(header) == raw_header);
+}
+
+TEST_CASE("[endian_np] stores in wire order")
+{
+  CONSTEXPR const auto big = lefticus::tools::big_np<std::uint32_t>::from(0x01020304);// NOLINT Magic Number
+  CONSTEXPR const auto little = lefticus::tools::little_np<std::uint32_t>::from(0x01020304);// NOLINT Magic Number
+
+  STATIC_REQUIRE(big.bytes() == std::array<unsigned char, 4>{ 1, 2, 3, 4 });// NOLINT Magic Number
+  STATIC_REQUIRE(little.bytes() == std::array<unsigned char, 4>{ 4, 3, 2, 1 });// NOLINT Magic Number
+  STATIC_REQUIRE(big.load() == little.load());
+}
+
+TEST_CASE("[endian_np] arithmetic is non-promoting")
+{
+  using lefticus::tools::big_np;
+  using lefticus::tools::uint_np16_t;
+
+  CONSTEXPR const auto lhs = big_np<std::uint16_t>::from(0xFFFF);// NOLINT Magic Number
+  CONSTEXPR const auto rhs = big_np<std::uint16_t>::from(2);
+
+  STATIC_REQUIRE(std::is_same_v<decltype(lhs + rhs), uint_np16_t>);
+  STATIC_REQUIRE(lhs + rhs == uint_np16_t::from(1));
+  STATIC_REQUIRE(lhs + uint_np16_t::from(3) == uint_np16_t::from(2));// NOLINT Magic Number
+  STATIC_REQUIRE((lhs >> 8) == uint_np16_t::from(0xFF));// NOLINT Magic Number
+  STATIC_REQUIRE(rhs < lhs);
+  STATIC_REQUIRE(lhs == uint_np16_t::from(0xFFFF));// NOLINT Magic Number
+}
+
+TEST_CASE("[endian_np] in place updates")
+{
+  constexpr auto header = [] {
+    auto result = std::bit_cast<wire_header>(raw_header);
+    result.length += 0x100;// NOLINT Magic Number
+    ++result.type;
+    result.offset -= lefticus::tools::int_np16_t::from(1);
+    result.type ^= lefticus::tools::uint_np16_t::from(0xFF00);// NOLINT Magic Number
+    return std::bit_cast<std::array<unsigned char, 8>>(result);
+  }();
+
+  STATIC_REQUIRE(header == std::array<unsigned char, 8>{ 0xED, 0x35, 0x00, 0x01, 0x03, 0x03, 0xFD, 0xFF });// NOLINT
+}
+
+TEST_CASE("[endian_np] overflow policy carries through")
+{
+  using saturating = lefticus::tools::little_np<std::uint8_t, lefticus::tools::overflow::saturate>;
+
+  constexpr auto result = [] {
+    auto value = saturating::from(250);// NOLINT Magic Number
+    value += 10;// NOLINT Magic Number
+    return value;
+  }();
+
+  STATIC_REQUIRE(result.get() == 255);// NOLINT Magic Number
+}
@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/non_promoting_kernels.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+namespace {
+// every pair of values for 8 bit types, the limits and a pseudo-random sample
+// otherwise. The odd length exercises the scalar tail as well as the vector blocks
+template<typename Int> std::pair<std::vector<Int>, std::vector<Int>> operand_pairs()
+{
+  using value_type = typename Int::value_type;
+  constexpr auto min = std::numeric_limits<value_type>::min();
+  constexpr auto max = std::numeric_limits<value_type>::max();
+
+  std::vector<value_type> values;
+  if constexpr (sizeof(value_type) == 1) {
+    for (int value = min; value <= max; ++value) { values.push_back(static_cast<value_type>(value)); }
+  } else {
+    values = { min, static_cast<value_type>(min + 1), 0, 1, 2, static_cast<value_type>(max - 1), max };
+    std::uint64_t seed = 1;
+    for (int count = 0; count < 40; ++count) {// NOLINT Magic Number
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;// NOLINT Magic Number
+      values.push_back(static_cast<value_type>(seed >> (count % 64)));// NOLINT Magic Number
+    }
+  }
+
+  std::pair<std::vector<Int>, std::vector<Int>> result;
+  for (const auto lhs : values) {
+    for (const auto rhs : values) {
+      result.first.push_back(Int{ lhs });
+      result.second.push_back(Int{ rhs });
+    }
+  }
+  result.first.push_back(Int{ max });
+  result.second.push_back(Int{ min });
+  return result;
+}
+
+template<typename Int> void check_binary_kernels()
+{
+  const auto [lhs, rhs] = operand_pairs<Int>();
+  std::vector<Int> result(lhs.size(), Int::from(0));
+
+  const auto check = [&](auto scalar_op) {
+    for (std::size_t index = 0; index < lhs.size(); ++index) {
+      if (result[index] != scalar_op(lhs[index], rhs[index])) {
+        FAIL_CHECK(+lhs[index].get() << " op " << +rhs[index].get() << " = " << +result[index].get());
+        return;
+      }
+    }
+  };
+
+  lefticus::tools::kernels::add(lhs, rhs, result);
+  check([](auto left, auto right) { return left + right; });
+  lefticus::tools::kernels::sub(lhs, rhs, result);
+  check([](auto left, auto right) { return left - right; });
+  lefticus::tools::kernels::mul(lhs, rhs, result);
+  check([](auto left, auto right) { return left * right; });
+  lefticus::tools::kernels::bit_and(lhs, rhs, result);
+  check([](auto left, auto right) { return left & right; });
+  lefticus::tools::kernels::bit_or(lhs, rhs, result);
+  check([](auto left, auto right) { return left | right; });
+  lefticus::tools::kernels::bit_xor(lhs, rhs, result);
+  check([](auto left, auto right) { return left ^ right; });
+
+  for (int count = 0; count < static_cast<int>(sizeof(Int) * 8); ++count) {
+    lefticus::tools::kernels::shift_left(lhs, count, result);
+    check([count](auto left, auto) { return left << count; });
+    lefticus::tools::kernels::shift_right(lhs, count, result);
+    check([count](auto left, auto) { return left >> count; });
+  }
+}
+}// namespace
+
+TEST_CASE("[kernels] int_np is layout identical to its underlying type")
+{
+  STATIC_REQUIRE(sizeof(lefticus::tools::uint_np8_t) == sizeof(std::uint8_t));
+  STATIC_REQUIRE(alignof(lefticus::tools::int_np64_t) == alignof(std::int64_t));
+  STATIC_REQUIRE(std::is_standard_layout_v<lefticus::tools::uint_sat16_t>);
+  STATIC_REQUIRE(std::is_trivially_copyable_v<lefticus::tools::int_np32_t>);
+  STATIC_REQUIRE(lefticus::tools::is_layout_identical_v<lefticus::tools::int_checked<std::int16_t>>);
+}
+
+TEST_CASE("[kernels] constexpr element-wise operations")
+{
+  using lefticus::tools::uint_sat8_t;
+
+  constexpr auto result = [] {
+    const std::array<uint_sat8_t, 3> lhs{
+      uint_sat8_t::from(250), uint_sat8_t::from(10), uint_sat8_t::from(0)// NOLINT Magic Number
+    };
+    const std::array<uint_sat8_t, 3> rhs{ uint_sat8_t::from(10), uint_sat8_t::from(20), uint_sat8_t::from(1) };// NOLINT
+    std::array<uint_sat8_t, 3> sum{ uint_sat8_t::from(0), uint_sat8_t::from(0), uint_sat8_t::from(0) };
+    lefticus::tools::kernels::add(lhs, rhs, sum);
+    std::array<uint_sat8_t, 3> difference = sum;
+    lefticus::tools::kernels::sub(lhs, rhs, difference);
+    return std::pair{ sum, difference };
+  }();
+
+  STATIC_REQUIRE(result.first[0] == uint_sat8_t::from(255));// NOLINT Magic Number
+  STATIC_REQUIRE(result.first[1] == uint_sat8_t::from(30));// NOLINT Magic Number
+  STATIC_REQUIRE(result.second[1] == uint_sat8_t::from(0));
+  STATIC_REQUIRE(result.second[2] == uint_sat8_t::from(0));
+}
+
+TEST_CASE("[kernels] vectorised results match the scalar operators")
+{
+  check_binary_kernels<lefticus::tools::uint_np8_t>();
+  check_binary_kernels<lefticus::tools::int_np8_t>();
+  check_binary_kernels<lefticus::tools::uint_sat8_t>();
+  check_binary_kernels<lefticus::tools::int_sat8_t>();
+  check_binary_kernels<lefticus::tools::uint_np16_t>();
+  check_binary_kernels<lefticus::tools::int_sat16_t>();
+  check_binary_kernels<lefticus::tools::uint_sat16_t>();
+  check_binary_kernels<lefticus::tools::int_np32_t>();
+  check_binary_kernels<lefticus::tools::int_sat32_t>();
+  check_binary_kernels<lefticus::tools::uint_sat64_t>();
+}
+
+TEST_CASE("[kernels] broadcast operand and spans")
+{
+  using lefticus::tools::uint_sat8_t;
+
+  std::vector<uint_sat8_t> samples(37, uint_sat8_t::from(200));// NOLINT Magic Number
+  samples[3] = uint_sat8_t::from(10);// NOLINT Magic Number
+
+  lefticus::tools::kernels::add(std::span{ samples }, uint_sat8_t::from(100), std::span{ samples });// NOLINT
+  CHECK(samples[0] == uint_sat8_t::from(255));// NOLINT Magic Number
+  CHECK(samples[3] == uint_sat8_t::from(110));// NOLINT Magic Number
+  CHECK(samples[36] == uint_sat8_t::from(255));// NOLINT Magic Number
+}
+
+TEST_CASE("[kernels] size mismatches and checked overflow throw")
+{
+  using checked = lefticus::tools::int_checked<std::uint8_t>;
+
+  const std::vector<checked> lhs(20, checked::from(200));// NOLINT Magic Number
+  std::vector<checked> result(19, checked::from(0));// NOLINT Magic Number
+  CHECK_THROWS_AS(lefticus::tools::kernels::add(lhs, lhs, result), std::invalid_argument);
+
+  result.resize(lhs.size(), checked::from(0));
+  CHECK_THROWS_AS(lefticus::tools::kernels::add(lhs, lhs, result), std::overflow_error);
+  CHECK_NOTHROW(lefticus::tools::kernels::bit_or(lhs, lhs, result));
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/non_promoting_wide_ints.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+namespace {
+constexpr std::uint64_t all_ones = std::numeric_limits<std::uint64_t>::max();
+
+constexpr std::uint64_t next_random(std::uint64_t &state)
+{
+  state = state * 6364136223846793005ULL + 1442695040888963407ULL;// NOLINT Magic Number
+  return state ^ (state >> 29U);// NOLINT Magic Number
+}
+}// namespace
+
+TEST_CASE("[uint_np] carries propagate across words")
+{
+  using lefticus::tools::uint_np128_t;
+
+  CONSTEXPR const auto max_low = uint_np128_t{ { all_ones, 0 } };
+  STATIC_REQUIRE((max_low + uint_np128_t::from(1)) == uint_np128_t{ { 0, 1 } });
+  STATIC_REQUIRE((uint_np128_t{ { 0, 1 } } - uint_np128_t::from(1)) == max_low);
+  STATIC_REQUIRE((uint_np128_t{} - uint_np128_t::from(1)) == uint_np128_t::from(-1));
+  STATIC_REQUIRE((uint_np128_t::from(-1) + uint_np128_t::from(1)) == uint_np128_t{});
+  STATIC_REQUIRE((max_low * max_low) == uint_np128_t{ { 1, all_ones - 1 } });
+}
+
+TEST_CASE("[uint_np] 256 bit multiplication wraps")
+{
+  using lefticus::tools::uint_np256_t;
+
+  // (2^128 - 1)^2 = 2^256 - 2^129 + 1
+  CONSTEXPR const auto value = uint_np256_t{ { all_ones, all_ones, 0, 0 } };
+  STATIC_REQUIRE((value * value) == uint_np256_t{ { 1, 0, all_ones - 1, all_ones } });
+  STATIC_REQUIRE((uint_np256_t::from(-1) * uint_np256_t::from(-1)) == uint_np256_t::from(1));
+}
+
+TEST_CASE("[uint_np] shifts and comparisons")
+{
+  using lefticus::tools::uint_np128_t;
+
+  CONSTEXPR const auto one = uint_np128_t::from(1);
+  STATIC_REQUIRE((one << 64) == uint_np128_t{ { 0, 1 } });// NOLINT Magic Number
+  STATIC_REQUIRE((one << 127) == uint_np128_t{ { 0, 1ULL << 63U } });// NOLINT Magic Number
+  STATIC_REQUIRE((one << 128) == uint_np128_t{});// NOLINT Magic Number
+  STATIC_REQUIRE(((one << 100) >> 99) == uint_np128_t::from(2));// NOLINT Magic Number
+  STATIC_REQUIRE((uint_np128_t{ { 0xF0, 0x0F } } >> 4) == uint_np128_t{ { 0xF000000000000000ULL | 0x0F, 0 } });// NOLINT
+  STATIC_REQUIRE((one << 64) > uint_np128_t::from(all_ones));// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np128_t::from(3) < uint_np128_t::from(4));// NOLINT Magic Number
+  STATIC_REQUIRE((~uint_np128_t{}) == uint_np128_t::from(-1));
+}
+
+TEST_CASE("[uint_np] increment and compound assignment")
+{
+  constexpr auto result = [] {
+    auto value = lefticus::tools::uint_np128_t::from(all_ones);
+    ++value;
+    value *= lefticus::tools::uint_np128_t::from(3);
+    value ^= lefticus::tools::uint_np128_t::from(1);
+    --value;
+    return value;
+  }();
+
+  STATIC_REQUIRE(result == lefticus::tools::uint_np128_t{ { 0, 3 } });
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST_CASE("[uint_np] 128 bit results match the builtin type")
+{
+  __extension__ typedef unsigned __int128 builtin;// NOLINT modernize-use-using
+
+  const auto to_builtin = [](const lefticus::tools::uint_np128_t &value) {
+    return (static_cast<builtin>(value.word(1)) << 64U) | value.word(0);
+  };
+
+  std::uint64_t state = 42;// NOLINT Magic Number
+  for (int count = 0; count < 1000; ++count) {// NOLINT Magic Number
+    const auto lhs = lefticus::tools::uint_np128_t{ { next_random(state), next_random(state) } };
+    const auto rhs = lefticus::tools::uint_np128_t{ { next_random(state), next_random(state) >> (count % 64) } };
+    const auto shift = static_cast<std::size_t>(count % 128);// NOLINT Magic Number
+
+    CHECK(to_builtin(lhs + rhs) == to_builtin(lhs) + to_builtin(rhs));
+    CHECK(to_builtin(lhs - rhs) == to_builtin(lhs) - to_builtin(rhs));
+    CHECK(to_builtin(lhs * rhs) == to_builtin(lhs) * to_builtin(rhs));
+    CHECK(to_builtin(lhs << shift) == to_builtin(lhs) << shift);
+    CHECK(to_builtin(lhs >> shift) == to_builtin(lhs) >> shift);
+    CHECK((lhs < rhs) == (to_builtin(lhs) < to_builtin(rhs)));
+  }
+}
+#endif
+
+TEST_CASE("[swar] lanes do not carry into each other")
+{
+  using lefticus::tools::u8x4_np;
+
+  CONSTEXPR const auto lhs = u8x4_np::from_lanes({ 250, 1, 0, 128 });// NOLINT Magic Number
+  CONSTEXPR const auto rhs = u8x4_np::from_lanes({ 10, 255, 1, 128 });// NOLINT Magic Number
+
+  STATIC_REQUIRE((lhs + rhs).lanes() == std::array<std::uint8_t, 4>{ 4, 0, 1, 0 });// NOLINT Magic Number
+  STATIC_REQUIRE((lhs - rhs).lanes() == std::array<std::uint8_t, 4>{ 240, 2, 255, 0 });// NOLINT Magic Number
+  STATIC_REQUIRE((lhs << 1).lanes() == std::array<std::uint8_t, 4>{ 244, 2, 0, 0 });// NOLINT Magic Number
+  STATIC_REQUIRE((rhs >> 4).lanes() == std::array<std::uint8_t, 4>{ 0, 15, 0, 8 });// NOLINT Magic Number
+  STATIC_REQUIRE(lhs.lane(0) == lefticus::tools::uint_np8_t::from(250));// NOLINT Magic Number
+  STATIC_REQUIRE(lhs.horizontal_sum() == 379U);// NOLINT Magic Number
+  STATIC_REQUIRE(u8x4_np::splat(7).get() == 0x07070707U);// NOLINT Magic Number
+}
+
+TEST_CASE("[swar] lane-wise results match int_np")
+{
+  using lefticus::tools::u16x4_np;
+  using lefticus::tools::uint_np16_t;
+
+  std::uint64_t state = 7;// NOLINT Magic Number
+  for (int count = 0; count < 1000; ++count) {// NOLINT Magic Number
+    const auto lhs = u16x4_np{ next_random(state) };
+    const auto rhs = u16x4_np{ next_random(state) };
+    const auto shift = static_cast<std::size_t>(count % 16);// NOLINT Magic Number
+
+    for (std::size_t index = 0; index < u16x4_np::lane_count; ++index) {
+      CHECK((lhs + rhs).lane(index) == lhs.lane(index) + rhs.lane(index));
+      CHECK((lhs - rhs).lane(index) == lhs.lane(index) - rhs.lane(index));
+      CHECK((lhs ^ rhs).lane(index) == (lhs.lane(index) ^ rhs.lane(index)));
+      CHECK((lhs << shift).lane(index) == (lhs.lane(index) << shift));
+      CHECK((lhs >> shift).lane(index) == (lhs.lane(index) >> shift));
+    }
+  }
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/non_promoting_ints.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// These compare the overflow policies against the hand-written loops
+// they replace; the policy versions should not be measurably slower.
+
+namespace {
+constexpr std::size_t sample_count = 1 << 16;
+
+// values in [0, range)
+template<typename Type> std::vector<Type> make_samples(std::uint32_t seed, const std::uint32_t range)
+{
+  std::vector<Type> result;
+  result.reserve(sample_count);
+  for (std::size_t index = 0; index < sample_count; ++index) {
+    seed = seed * 1103515245U + 12345U;// NOLINT Magic Number
+    result.push_back(Type::from((seed >> 16U) % range));// NOLINT Magic Number
+  }
+  return result;
+}
+
+template<typename Type> std::vector<typename Type::value_type> underlying(const std::vector<Type> &values)
+{
+  std::vector<typename Type::value_type> result;
+  result.reserve(values.size());
+  for (const auto value : values) { result.push_back(value.get()); }
+  return result;
+}
+}// namespace
+
+TEST_CASE("[int_np] saturating uint8 add", "[!benchmark]")
+{
+  using lefticus::tools::int_sat;
+  const auto lhs = make_samples<int_sat<std::uint8_t>>(1, 256);// NOLINT Magic Number
+  const auto rhs = make_samples<int_sat<std::uint8_t>>(2, 256);// NOLINT Magic Number
+  const auto raw_lhs = underlying(lhs);
+  const auto raw_rhs = underlying(rhs);
+
+  std::vector<int_sat<std::uint8_t>> result(sample_count, int_sat<std::uint8_t>::from(0));
+  std::vector<std::uint8_t> raw_result(sample_count);
+
+  BENCHMARK("uint_sat8_t")
+  {
+    std::transform(lhs.begin(), lhs.end(), rhs.begin(), result.begin(), [](auto left, auto right) {
+      return left + right;
+    });
+    return result.back();
+  };
+
+  BENCHMARK("hand-written")
+  {
+    std::transform(raw_lhs.begin(), raw_lhs.end(), raw_rhs.begin(), raw_result.begin(), [](auto left, auto right) {
+      return static_cast<std::uint8_t>(std::min(left + right, 255));// NOLINT Magic Number
+    });
+    return raw_result.back();
+  };
+}
+
+TEST_CASE("[int_np] saturating int16 multiply-accumulate", "[!benchmark]")
+{
+  using lefticus::tools::int_sat;
+  const auto lhs = make_samples<int_sat<std::int16_t>>(3, 180);// NOLINT Magic Number
+  const auto rhs = make_samples<int_sat<std::int16_t>>(4, 180);// NOLINT Magic Number
+  const auto raw_lhs = underlying(lhs);
+  const auto raw_rhs = underlying(rhs);
+
+  BENCHMARK("int_sat16_t")
+  {
+    auto accumulator = int_sat<std::int16_t>::from(0);
+    for (std::size_t index = 0; index < sample_count; ++index) { accumulator += lhs[index] * rhs[index]; }
+    return accumulator;
+  };
+
+  BENCHMARK("hand-written")
+  {
+    std::int16_t accumulator = 0;
+    for (std::size_t index = 0; index < sample_count; ++index) {
+      const int product = std::clamp(raw_lhs[index] * raw_rhs[index], -32768, 32767);// NOLINT Magic Number
+      accumulator = static_cast<std::int16_t>(std::clamp(accumulator + product, -32768, 32767));// NOLINT Magic Number
+    }
+    return accumulator;
+  };
+}
+
+TEST_CASE("[int_np] checked uint32 sum", "[!benchmark]")
+{
+  const auto values = make_samples<lefticus::tools::int_checked<std::uint32_t>>(5, 65536);// NOLINT Magic Number
+  const auto raw_values = underlying(values);
+
+  BENCHMARK("int_checked<uint32_t>")
+  {
+    auto sum = lefticus::tools::int_checked<std::uint32_t>::from(0);
+    for (const auto value : values) { sum += value; }
+    return sum;
+  };
+
+  BENCHMARK("hand-written")
+  {
+    std::uint32_t sum = 0;
+    for (const auto value : raw_values) {
+      if (value > std::numeric_limits<std::uint32_t>::max() - sum) { throw std::overflow_error("overflow"); }
+      sum += value;
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("[int_np] fast_divider against hardware division", "[!benchmark]")
+{
+  using lefticus::tools::uint_np32_t;
+  const auto values = make_samples<uint_np32_t>(6, 65536);// NOLINT Magic Number
+
+  // keep the divisor opaque to the optimiser, it is "configured at runtime"
+  volatile std::uint32_t configured = 1021;// NOLINT Magic Number
+  const auto divisor = uint_np32_t{ configured };
+  const auto divider = lefticus::tools::fast_divider<uint_np32_t>{ divisor };
+
+  BENCHMARK("operator/")
+  {
+    auto sum = uint_np32_t::from(0);
+    for (const auto value : values) { sum += value / divisor; }
+    return sum;
+  };
+
+  BENCHMARK("fast_divider")
+  {
+    auto sum = uint_np32_t::from(0);
+    for (const auto value : values) { sum += value / divider; }
+    return sum;
+  };
+}
@@ -1,5 +1,8 @@
 #include <catch2/catch.hpp>
 #include <lefticus/tools/non_promoting_ints.hpp>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 
 #ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
 #define CONSTEXPR
@@ -66,3 +69,212 @@ TEST_CASE("[int_np] is only constructible from underlying type")
   STATIC_REQUIRE(std::is_constructible_v<lefticus::tools::int_np8_t, std::int8_t>);
   STATIC_REQUIRE(!std::is_constructible_v<lefticus::tools::int_np8_t, std::uint8_t>);
 }
+
+
+TEST_CASE("[int_np] wrap policy is modular for signed types")
+{
+  using lefticus::tools::int_np32_t;
+  using lefticus::tools::int_np8_t;
+
+  constexpr auto max32 = std::numeric_limits<std::int32_t>::max();
+  constexpr auto min32 = std::numeric_limits<std::int32_t>::min();
+
+  STATIC_REQUIRE((int_np32_t::from(max32) + int_np32_t::from(1)) == int_np32_t::from(min32));
+  STATIC_REQUIRE((int_np32_t::from(min32) - int_np32_t::from(1)) == int_np32_t::from(max32));
+  STATIC_REQUIRE((int_np32_t::from(min32) / int_np32_t::from(-1)) == int_np32_t::from(min32));
+  STATIC_REQUIRE((int_np32_t::from(min32) % int_np32_t::from(-1)) == int_np32_t::from(0));
+  STATIC_REQUIRE((int_np8_t::from(100) * int_np8_t::from(3)) == int_np8_t::from(44));// NOLINT Magic Number
+}
+
+TEST_CASE("[int_np] compound operators")
+{
+  constexpr auto result = [] {
+    auto value = lefticus::tools::uint_np16_t::from(250);// NOLINT Magic Number
+    value += 10;// NOLINT Magic Number
+    value *= lefticus::tools::uint_np16_t::from(3);
+    value -= 1;
+    value %= 100;// NOLINT Magic Number
+    value /= lefticus::tools::uint_np16_t::from(2);
+    return value;
+  }();
+
+  STATIC_REQUIRE(result == lefticus::tools::uint_np16_t::from(39));// NOLINT Magic Number
+}
+
+TEST_CASE("[int_np] saturating arithmetic clamps to the type limits")
+{
+  using lefticus::tools::int_sat8_t;
+  using lefticus::tools::uint_sat8_t;
+
+  STATIC_REQUIRE((uint_sat8_t::from(200) + uint_sat8_t::from(100)) == uint_sat8_t::from(255));// NOLINT Magic Number
+  STATIC_REQUIRE((uint_sat8_t::from(10) - uint_sat8_t::from(20)) == uint_sat8_t::from(0));// NOLINT Magic Number
+  STATIC_REQUIRE((uint_sat8_t::from(20) * uint_sat8_t::from(20)) == uint_sat8_t::from(255));// NOLINT Magic Number
+  STATIC_REQUIRE((uint_sat8_t::from(20) + uint_sat8_t::from(20)) == uint_sat8_t::from(40));// NOLINT Magic Number
+
+  STATIC_REQUIRE((int_sat8_t::from(100) + int_sat8_t::from(100)) == int_sat8_t::from(127));// NOLINT Magic Number
+  STATIC_REQUIRE((int_sat8_t::from(-100) + int_sat8_t::from(-100)) == int_sat8_t::from(-128));// NOLINT Magic Number
+  STATIC_REQUIRE((int_sat8_t::from(-100) - int_sat8_t::from(100)) == int_sat8_t::from(-128));// NOLINT Magic Number
+  STATIC_REQUIRE((int_sat8_t::from(100) - int_sat8_t::from(-100)) == int_sat8_t::from(127));// NOLINT Magic Number
+  STATIC_REQUIRE((int_sat8_t::from(-20) * int_sat8_t::from(20)) == int_sat8_t::from(-128));// NOLINT Magic Number
+  STATIC_REQUIRE((int_sat8_t::from(-20) * int_sat8_t::from(-20)) == int_sat8_t::from(127));// NOLINT Magic Number
+  STATIC_REQUIRE((int_sat8_t::from(-128) / int_sat8_t::from(-1)) == int_sat8_t::from(127));// NOLINT Magic Number
+}
+
+TEST_CASE("[int_np] saturating arithmetic with mixed integral operands")
+{
+  constexpr auto result = [] {
+    auto value = lefticus::tools::uint_sat8_t::from(200);// NOLINT Magic Number
+    value += -50;// NOLINT Magic Number
+    const auto after_add = value;
+    value -= 1000;// NOLINT Magic Number
+    return std::pair{ after_add, value };
+  }();
+
+  STATIC_REQUIRE(result.first == lefticus::tools::uint_sat8_t::from(150));// NOLINT Magic Number
+  STATIC_REQUIRE(result.second == lefticus::tools::uint_sat8_t::from(0));
+  STATIC_REQUIRE(lefticus::tools::uint_sat8_t::from(1000) == lefticus::tools::uint_sat8_t::from(255));// NOLINT
+  STATIC_REQUIRE(lefticus::tools::int_sat16_t::from(-100000) == lefticus::tools::int_sat16_t::from(-32768));// NOLINT
+}
+
+TEST_CASE("[int_np] saturating increment and decrement stop at the limits")
+{
+  constexpr auto result = [] {
+    auto value = lefticus::tools::uint_sat8_t::from(254);// NOLINT Magic Number
+    ++value;
+    ++value;
+    const auto high = value;
+    value = lefticus::tools::uint_sat8_t::from(1);
+    --value;
+    --value;
+    return std::pair{ high, value };
+  }();
+
+  STATIC_REQUIRE(result.first == lefticus::tools::uint_sat8_t::from(255));// NOLINT Magic Number
+  STATIC_REQUIRE(result.second == lefticus::tools::uint_sat8_t::from(0));
+}
+
+TEST_CASE("[int_np] checked arithmetic")
+{
+  using checked8 = lefticus::tools::int_checked<std::int8_t>;
+  using checked_u16 = lefticus::tools::int_checked<std::uint16_t>;
+
+  STATIC_REQUIRE((checked8::from(100) + checked8::from(27)) == checked8::from(127));// NOLINT Magic Number
+  STATIC_REQUIRE((checked_u16::from(300) * checked_u16::from(200)) == checked_u16::from(60000));// NOLINT Magic Number
+  STATIC_REQUIRE(!noexcept(checked8::from(1) + checked8::from(1)));
+  STATIC_REQUIRE(noexcept(lefticus::tools::int_np8_t::from(1) + lefticus::tools::int_np8_t::from(1)));
+
+  CHECK_THROWS_AS(checked8::from(100) + checked8::from(28), std::overflow_error);// NOLINT Magic Number
+  CHECK_THROWS_AS(checked8::from(-128) - checked8::from(1), std::overflow_error);// NOLINT Magic Number
+  CHECK_THROWS_AS(checked8::from(-128) / checked8::from(-1), std::overflow_error);// NOLINT Magic Number
+  CHECK_THROWS_AS(checked_u16::from(300) * checked_u16::from(300), std::overflow_error);// NOLINT Magic Number
+  CHECK_THROWS_AS(checked_u16::from(3) - checked_u16::from(4), std::overflow_error);
+  CHECK_THROWS_AS(checked_u16::from(3) / checked_u16::from(0), std::domain_error);
+  CHECK_THROWS_AS(checked_u16::from(3) % checked_u16::from(0), std::domain_error);
+  CHECK_THROWS_AS(checked_u16::from(-1), std::overflow_error);
+}
+
+TEST_CASE("[int_np] bit manipulation keeps the exact type")
+{
+  using lefticus::tools::int_np8_t;
+  using lefticus::tools::uint_np16_t;
+  using lefticus::tools::uint_np32_t;
+  using lefticus::tools::uint_np8_t;
+
+  STATIC_REQUIRE(uint_np8_t::from(0xF0).popcount() == 4);// NOLINT Magic Number
+  STATIC_REQUIRE(int_np8_t::from(-1).popcount() == 8);// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np16_t::from(1).countl_zero() == 15);// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np32_t::from(8).countr_zero() == 3);// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np8_t::from(0x81).rotl(1) == uint_np8_t::from(0x03));// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np8_t::from(0x81).rotr(1) == uint_np8_t::from(0xC0));// NOLINT Magic Number
+  STATIC_REQUIRE(std::is_same_v<decltype(int_np8_t::from(1).rotl(1)), int_np8_t>);
+  STATIC_REQUIRE(uint_np32_t::from(0x11223344).byteswap() == uint_np32_t::from(0x44332211));// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np8_t::from(0xAB).byteswap() == uint_np8_t::from(0xAB));// NOLINT Magic Number
+  STATIC_REQUIRE(lefticus::tools::int_np16_t::from(0x0180).byteswap() == lefticus::tools::int_np16_t::from(-32767));
+  STATIC_REQUIRE(uint_np16_t::from(64).has_single_bit());// NOLINT Magic Number
+  STATIC_REQUIRE(!uint_np16_t::from(65).has_single_bit());// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np16_t::from(65).bit_floor() == uint_np16_t::from(64));// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np16_t::from(65).bit_width() == 7);// NOLINT Magic Number
+}
+
+TEST_CASE("[int_np] bit_ceil follows the overflow policy")
+{
+  using lefticus::tools::uint_np8_t;
+  using lefticus::tools::uint_sat8_t;
+
+  STATIC_REQUIRE(uint_np8_t::from(0).bit_ceil() == uint_np8_t::from(1));
+  STATIC_REQUIRE(uint_np8_t::from(64).bit_ceil() == uint_np8_t::from(64));// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np8_t::from(65).bit_ceil() == uint_np8_t::from(128));// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np8_t::from(129).bit_ceil() == uint_np8_t::from(0));// NOLINT Magic Number
+  STATIC_REQUIRE(uint_sat8_t::from(129).bit_ceil() == uint_sat8_t::from(255));// NOLINT Magic Number
+  CHECK_THROWS_AS(lefticus::tools::int_checked<std::uint8_t>::from(129).bit_ceil(), std::overflow_error);// NOLINT
+}
+
+TEST_CASE("[int_np] fast_divider")
+{
+  using lefticus::tools::fast_divider;
+  using lefticus::tools::uint_np32_t;
+
+  CONSTEXPR const auto divider = fast_divider<uint_np32_t>{ uint_np32_t::from(7) };// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np32_t::from(100) / divider == uint_np32_t::from(14));// NOLINT Magic Number
+  STATIC_REQUIRE(uint_np32_t::from(100) % divider == uint_np32_t::from(2));// NOLINT Magic Number
+  STATIC_REQUIRE(divider.divisor() == uint_np32_t::from(7));// NOLINT Magic Number
+
+  CHECK_THROWS_AS(fast_divider<uint_np32_t>{ uint_np32_t::from(0) }, std::domain_error);
+}
+
+namespace {
+template<typename Int> void check_all_8_bit_divisions()
+{
+  for (int divisor = -128; divisor < 256; ++divisor) {// NOLINT Magic Number
+    if (divisor == 0 || !std::in_range<typename Int::value_type>(divisor)) { continue; }
+    const auto divider = lefticus::tools::fast_divider<Int>{ Int::from(divisor) };
+    for (int dividend = -128; dividend < 256; ++dividend) {// NOLINT Magic Number
+      if (!std::in_range<typename Int::value_type>(dividend)) { continue; }
+      const auto lhs = Int::from(dividend);
+      const auto rhs = Int::from(divisor);
+      if (lhs / divider != lhs / rhs || lhs % divider != lhs % rhs) {
+        FAIL_CHECK(dividend << " / " << divisor);
+        return;
+      }
+    }
+  }
+}
+
+template<typename Int> void check_sampled_divisions()
+{
+  using value_type = typename Int::value_type;
+  std::uint64_t state = 3;// NOLINT Magic Number
+  const auto next = [&state] {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;// NOLINT Magic Number
+    return state ^ (state >> 29U);// NOLINT Magic Number
+  };
+
+  for (int count = 0; count < 2000; ++count) {// NOLINT Magic Number
+    auto divisor = static_cast<value_type>(next() >> (count % 64));// NOLINT Magic Number
+    if (divisor == 0) { divisor = 1; }
+    const auto divider = lefticus::tools::fast_divider<Int>{ Int{ divisor } };
+    for (int sample = 0; sample < 50; ++sample) {// NOLINT Magic Number
+      const auto lhs = Int{ static_cast<value_type>(next() >> (sample % 64)) };
+      if (lhs / divider != lhs / Int{ divisor } || lhs % divider != lhs % Int{ divisor }) {
+        FAIL_CHECK(+lhs.get() << " / " << +divisor);
+        return;
+      }
+    }
+  }
+  const auto max = Int{ std::numeric_limits<value_type>::max() };
+  CHECK(max / lefticus::tools::fast_divider<Int>{ max } == Int::from(1));
+}
+}// namespace
+
+TEST_CASE("[int_np] fast_divider matches operator/ and operator%")
+{
+  check_all_8_bit_divisions<lefticus::tools::uint_np8_t>();
+  check_all_8_bit_divisions<lefticus::tools::int_np8_t>();
+  check_all_8_bit_divisions<lefticus::tools::int_sat8_t>();
+  check_sampled_divisions<lefticus::tools::uint_np16_t>();
+  check_sampled_divisions<lefticus::tools::int_np16_t>();
+  check_sampled_divisions<lefticus::tools::uint_np32_t>();
+  check_sampled_divisions<lefticus::tools::int_np32_t>();
+  check_sampled_divisions<lefticus::tools::uint_np64_t>();
+  check_sampled_divisions<lefticus::tools::int_np64_t>();
+}
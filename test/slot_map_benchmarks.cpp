@@ -0,0 +1,101 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/slot_map.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// slot_map against the unordered_map it is meant to replace for entity storage
+
+namespace {
+constexpr std::size_t entity_count = 1 << 14;
+constexpr std::size_t lookup_count = 1 << 16;
+
+struct Entity;
+
+struct transform
+{
+  float x;
+  float y;
+  float z;
+};
+
+// indices in [0, entity_count), in a scrambled order
+std::vector<std::size_t> make_lookups(std::uint32_t seed)
+{
+  std::vector<std::size_t> result;
+  result.reserve(lookup_count);
+  for (std::size_t index = 0; index < lookup_count; ++index) {
+    seed = seed * 1103515245U + 12345U;// NOLINT Magic Number
+    result.push_back((seed >> 8U) % entity_count);// NOLINT Magic Number
+  }
+  return result;
+}
+}// namespace
+
+TEST_CASE("[slot_map] lookup by id", "[!benchmark]")
+{
+  const auto lookups = make_lookups(1);
+
+  lefticus::tools::slot_map<transform, Entity> slots;
+  std::vector<lefticus::tools::slot_map_id<Entity>> slot_ids;
+  std::unordered_map<std::uint32_t, transform> hashed;
+  std::vector<std::uint32_t> hashed_ids;
+
+  for (std::size_t index = 0; index < entity_count; ++index) {
+    const auto value = static_cast<float>(index);
+    slot_ids.push_back(slots.insert(transform{ value, value, value }));
+    // sparse keys, as entity ids usually are
+    const auto key = static_cast<std::uint32_t>(index * 7919U);// NOLINT Magic Number
+    hashed.emplace(key, transform{ value, value, value });
+    hashed_ids.push_back(key);
+  }
+
+  BENCHMARK("slot_map")
+  {
+    float total = 0;
+    for (const auto lookup : lookups) { total += slots[slot_ids[lookup]].x; }
+    return total;
+  };
+
+  BENCHMARK("unordered_map")
+  {
+    float total = 0;
+    for (const auto lookup : lookups) { total += hashed.find(hashed_ids[lookup])->second.x; }
+    return total;
+  };
+}
+
+TEST_CASE("[slot_map] churn", "[!benchmark]")
+{
+  const auto lookups = make_lookups(2);
+
+  BENCHMARK("slot_map")
+  {
+    lefticus::tools::slot_map<transform, Entity> slots;
+    std::vector<lefticus::tools::slot_map_id<Entity>> ids(entity_count);
+    for (auto &id : ids) { id = slots.insert(transform{}); }
+    for (const auto lookup : lookups) {
+      slots.erase(ids[lookup]);
+      ids[lookup] = slots.insert(transform{});
+    }
+    return slots.size();
+  };
+
+  BENCHMARK("unordered_map")
+  {
+    std::unordered_map<std::uint32_t, transform> hashed;
+    std::vector<std::uint32_t> ids(entity_count);
+    std::uint32_t next_id = 0;
+    for (auto &id : ids) {
+      id = next_id++;
+      hashed.emplace(id, transform{});
+    }
+    for (const auto lookup : lookups) {
+      hashed.erase(ids[lookup]);
+      ids[lookup] = next_id++;
+      hashed.emplace(ids[lookup], transform{});
+    }
+    return hashed.size();
+  };
+}
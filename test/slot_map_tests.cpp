@@ -0,0 +1,104 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/slot_map.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+using lefticus::tools::slot_map;
+
+struct Entity;
+using EntityId = lefticus::tools::slot_map_id<Entity>;
+
+TEST_CASE("slot_map lookups by id")
+{
+  STATIC_REQUIRE([] {
+    slot_map<int, Entity> entities;
+    const auto first = entities.insert(1);
+    const auto second = entities.emplace(2);
+    return entities[first] + entities[second] * 10;// NOLINT Magic Number
+  }() == 21);
+
+  STATIC_REQUIRE([] {
+    lefticus::tools::simple_stack_slot_map<int, Entity, 8> entities;// NOLINT Magic Number
+    const auto first = entities.insert(1);
+    const auto second = entities.insert(2);
+    entities.erase(first);
+    const auto third = entities.insert(3);
+    return entities.size() == 2 && entities[second] == 2 && entities[third] == 3 && !entities.contains(first);
+  }());
+}
+
+TEST_CASE("slot_map ids are generational")
+{
+  STATIC_REQUIRE([] {
+    slot_map<int, Entity> entities;
+    const auto first = entities.insert(1);
+    entities.erase(first);
+    const auto reused = entities.insert(2);
+    // same slot, different generation
+    return reused.index == first.index && reused.generation != first.generation && !entities.contains(first)
+           && entities.find(first) == nullptr && *entities.find(reused) == 2;
+  }());
+
+  STATIC_REQUIRE([] {
+    slot_map<int, Entity> entities;
+    const auto first = entities.insert(1);
+    return entities.erase(first) && !entities.erase(first) && entities.empty();
+  }());
+
+  STATIC_REQUIRE(!slot_map<int, Entity>{}.contains(EntityId{}));
+}
+
+TEST_CASE("slot_map keeps values dense")
+{
+  slot_map<std::string, Entity> names;
+  std::vector<EntityId> ids;
+  for (const auto *name : { "a", "b", "c", "d", "e" }) { ids.push_back(names.insert(name)); }
+
+  CHECK(names.erase(ids[1]));
+  CHECK(names.erase(ids[3]));
+  CHECK(names.size() == 3);
+
+  std::vector<std::string> remaining(names.begin(), names.end());
+  std::sort(remaining.begin(), remaining.end());
+  CHECK(remaining == std::vector<std::string>{ "a", "c", "e" });
+
+  for (const auto id : { ids[0], ids[2], ids[4] }) { CHECK(names.contains(id)); }
+  CHECK(names[ids[4]] == "e");
+
+  for (std::size_t offset = 0; offset < names.size(); ++offset) {
+    CHECK(names[names.id_at(offset)] == *std::next(names.begin(), static_cast<std::ptrdiff_t>(offset)));
+  }
+}
+
+TEST_CASE("slot_map checks stale ids")
+{
+  slot_map<int, Entity> entities;
+  const auto id = entities.insert(1);
+  entities.erase(id);
+
+  CHECK_THROWS_AS(entities.at(id), std::out_of_range);
+  if constexpr (lefticus::tools::debug_validation) { CHECK_THROWS_AS(entities[id], std::out_of_range); }
+
+  const auto kept = entities.insert(2);
+  entities.clear();
+  CHECK(entities.empty());
+  CHECK(!entities.contains(kept));
+
+  const auto after_clear = entities.insert(3);
+  CHECK(entities.at(after_clear) == 3);
+
+  lefticus::tools::simple_stack_slot_map<int, Entity, 1> full;
+  full.insert(1);
+  CHECK_THROWS_AS(full.insert(2), std::length_error);
+  CHECK(full.size() == 1);
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/simple_stack_flat_map.hpp>
+#include <lefticus/tools/simple_stack_string.hpp>
+#include <lefticus/tools/simple_stack_vector.hpp>
+#include <lefticus/tools/stackify_footprint.hpp>
+
+#include <optional>
+#include <sstream>
+#include <string>
+#include <variant>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+
+namespace {
+template<typename T> using vector = lefticus::tools::simple_stack_vector<T, 16>;// NOLINT Magic Number
+template<typename Key, typename Value>
+using map = lefticus::tools::simple_stack_flat_map<Key, Value, 16>;// NOLINT Magic Number
+using string = lefticus::tools::simple_stack_string<16>;// NOLINT Magic Number
+
+constexpr auto make_data()
+{
+  map<string, vector<int>> data;
+  data["hello"].push_back(42);// NOLINT Magic Number
+  data["hello"].push_back(43);// NOLINT Magic Number
+  data["world"].push_back(84);// NOLINT Magic Number
+  return data;
+}
+}// namespace
+
+
+TEST_CASE("[minimized_stackify_footprint] reports each level")// NOLINT (cognitive complexity)
+{
+  CONSTEXPR auto report = lefticus::tools::minimized_stackify_footprint<32>([]() { return make_data(); });
+
+  STATIC_REQUIRE(report.levels.size() == 2);
+
+  // the map itself
+  STATIC_REQUIRE(report.levels[0].capacity == 2);
+  STATIC_REQUIRE(report.levels[0].containers == 1);
+  STATIC_REQUIRE(report.levels[0].elements_used == 2);
+  STATIC_REQUIRE(report.levels[0].bytes_used == report.levels[0].bytes_reserved);
+
+  // the keys and the values
+  STATIC_REQUIRE(report.levels[1].capacity == 5);// NOLINT Magic Number
+  STATIC_REQUIRE(report.levels[1].containers == 4);// NOLINT Magic Number
+  STATIC_REQUIRE(report.levels[1].elements_used == 5 + 5 + 2 + 1);// NOLINT Magic Number
+  STATIC_REQUIRE(report.levels[1].bytes_used <= report.levels[1].bytes_reserved);
+}
+
+TEST_CASE("[measure_footprint] counts storage that wrappers reserve but do not use")
+{
+  CONSTEXPR auto empty = [] {
+    lefticus::tools::footprint_report report;
+    lefticus::tools::measure_footprint(std::optional<vector<int>>{}, report, 0);
+    return report;
+  }();
+  STATIC_REQUIRE(empty.levels.size() == 1);
+  STATIC_REQUIRE(empty.levels[0].capacity == 16);// NOLINT Magic Number
+  STATIC_REQUIRE(empty.levels[0].elements_used == 0);
+  STATIC_REQUIRE(empty.levels[0].bytes_reserved == 16 * sizeof(int));// NOLINT Magic Number
+
+  CONSTEXPR auto variant = [] {
+    lefticus::tools::footprint_report report;
+    lefticus::tools::measure_footprint(std::variant<int, vector<int>>{ 1 }, report, 0);
+    return report;
+  }();
+  STATIC_REQUIRE(variant.levels.size() == 1);
+  STATIC_REQUIRE(variant.levels[0].containers == 0);
+  STATIC_REQUIRE(variant.levels[0].bytes_used == 0);
+  STATIC_REQUIRE(variant.levels[0].bytes_reserved == 16 * sizeof(int));// NOLINT Magic Number
+}
+
+TEST_CASE("[minimized_stackify_footprint] reports bytes saved")
+{
+  CONSTEXPR auto report = lefticus::tools::minimized_stackify_footprint<32>([]() { return make_data(); });
+
+  STATIC_REQUIRE(report.total_size == sizeof(lefticus::tools::minimized_stackify<32>([]() { return make_data(); })));
+  STATIC_REQUIRE(report.input_size == sizeof(make_data()));
+  STATIC_REQUIRE(report.bytes_saved() > 0);
+}
+
+TEST_CASE("[minimized_stackify_footprint] can be printed")
+{
+  const auto report = lefticus::tools::minimized_stackify_footprint<32>([]() { return make_data(); });
+
+  std::ostringstream out;
+  out << report;
+
+  // shown with -s, so the table can be inspected when sizing embedded data
+  INFO(out.str());
+  REQUIRE(out.str().find("bytes reserved") != std::string::npos);
+  REQUIRE(out.str().find("saved: " + std::to_string(report.bytes_saved())) != std::string::npos);
+}
+
+TEST_CASE("[footprint_report] reports growth instead of wrapping around")
+{
+  lefticus::tools::footprint_report report;
+  report.total_size = 48;// NOLINT Magic Number
+  report.input_size = 40;// NOLINT Magic Number
+  CHECK(report.bytes_saved() == -8);
+
+  std::ostringstream out;
+  out << report;
+  REQUIRE(out.str().find("grew: 8)") != std::string::npos);
+}
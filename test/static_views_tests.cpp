@@ -1,10 +1,18 @@
 #include <catch2/catch.hpp>
 #include <lefticus/tools/flat_map.hpp>
+#include <lefticus/tools/non_promoting_ints.hpp>
 #include <lefticus/tools/simple_stack_flat_map.hpp>
 #include <lefticus/tools/simple_stack_string.hpp>
 #include <lefticus/tools/simple_stack_vector.hpp>
 #include <lefticus/tools/static_views.hpp>
 
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <variant>
+
 #ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
 #define CONSTEXPR
 #else
@@ -87,6 +95,80 @@ TEST_CASE("[to_string_view] produces an std::string_view from simple_stack_strin
   STATIC_REQUIRE(result.size() == 6);// NOLINT Magic Number
 }
 
+constexpr auto make_unsorted_vector_like()
+{
+  return lefticus::tools::simple_stack_vector<int, 16>{ 9, 3, 7, 1, 10, 5, 2, 8, 6, 4 };// NOLINT Magic Number
+}
+
+TEST_CASE("[to_eytzinger_array] produces a sorted BFS layout")
+{
+  CONSTEXPR auto result = lefticus::tools::to_eytzinger_array([]() { return make_unsorted_vector_like(); });
+  STATIC_REQUIRE(result == std::array{ 7, 4, 9, 2, 6, 8, 10, 1, 3, 5 });// NOLINT Magic Number
+}
+
+TEST_CASE("[to_eytzinger_span] can be searched")
+{
+  CONSTEXPR const auto result = lefticus::tools::to_eytzinger_span([]() { return make_unsorted_vector_like(); });
+  static_assert(std::is_same_v<decltype(result), const std::span<const int>>);
+  STATIC_REQUIRE(*lefticus::tools::eytzinger_find(result, 6) == 6);// NOLINT Magic Number
+  STATIC_REQUIRE(lefticus::tools::eytzinger_find(result, 11) == result.end());// NOLINT Magic Number
+}
+
+constexpr auto make_routes()
+{
+  using route = lefticus::tools::pair<int, int>;
+  return lefticus::tools::simple_stack_vector<route, 8>{// NOLINT Magic Number
+    route{ 443, 2 },// NOLINT Magic Number
+    route{ 80, 1 },// NOLINT Magic Number
+    route{ 8080, 3 },// NOLINT Magic Number
+    route{ 22, 0 }// NOLINT Magic Number
+  };
+}
+
+TEST_CASE("[to_eytzinger_span] supports keyed lookup with a projection")
+{
+  constexpr auto key = [](const auto &value) { return value.first; };
+  CONSTEXPR const auto routes = lefticus::tools::to_eytzinger_span([]() { return make_routes(); }, key);
+
+  STATIC_REQUIRE(lefticus::tools::eytzinger_find(routes, 8080, key)->second == 3);// NOLINT Magic Number
+  STATIC_REQUIRE(lefticus::tools::eytzinger_find(routes, 22, key)->second == 0);// NOLINT Magic Number
+  STATIC_REQUIRE(lefticus::tools::eytzinger_find(routes, 23, key) == routes.end());// NOLINT Magic Number
+}
+
+constexpr auto make_strings()
+{
+  using namespace std::string_view_literals;
+  return std::array{ "application/json"sv, "json"sv, "text/plain"sv, "plain"sv, "json"sv, "text/html"sv, ""sv };
+}
+
+TEST_CASE("[to_string_table] shares duplicate and suffix storage")// NOLINT (cognitive complexity)
+{
+  CONSTEXPR static auto table = lefticus::tools::to_string_table([]() { return make_strings(); });
+
+  STATIC_REQUIRE(table.size() == make_strings().size());
+  STATIC_REQUIRE(table.blob.size() == std::string_view{ "application/jsontext/plaintext/html" }.size());
+  STATIC_REQUIRE(sizeof(lefticus::tools::string_handle) <= 8);
+
+  STATIC_REQUIRE(table.at(0) == "application/json");
+  STATIC_REQUIRE(table.at(1) == "json");
+  STATIC_REQUIRE(table.at(2) == "text/plain");
+  STATIC_REQUIRE(table.at(3) == "plain");
+  STATIC_REQUIRE(table.at(4) == "json");// NOLINT Magic Number
+  STATIC_REQUIRE(table.at(5) == "text/html");// NOLINT Magic Number
+  STATIC_REQUIRE(table.at(6).empty());// NOLINT Magic Number
+
+  STATIC_REQUIRE(table.handles[1] == table.handles[4]);// NOLINT Magic Number
+}
+
+TEST_CASE("[to_string_table_view] produces a view of static storage")
+{
+  CONSTEXPR const auto table = lefticus::tools::to_string_table_view([]() { return make_strings(); });
+
+  STATIC_REQUIRE(table.size() == make_strings().size());
+  STATIC_REQUIRE(table.at(2) == "text/plain");
+  STATIC_REQUIRE(table[table.handles[3]] == "plain");// NOLINT Magic Number
+}
+
 
 TEST_CASE("[resize] can right-size a container level 1")// NOLINT (cognitive complexity)
 {
@@ -156,6 +238,45 @@ TEST_CASE("[minimized_stackify] works")// NOLINT (cognitive complexity)
   STATIC_REQUIRE(minimized.at("hello").at("world").capacity() == 1);
 }
 
+template<typename Name, typename Values> struct config_entry
+{
+  Name name;
+  Values values;
+};
+
+// NOLINTNEXTLINE (cognitive complexity)
+TEST_CASE("[minimized_stackify] works with optional, variant, array, tuple and aggregates")
+{
+  const auto make_data = []() {
+    return std::tuple{ std::optional<string>{ "hostname" },
+      std::variant<int, string>{ string{ "eth0" } },
+      std::array<string, 2>{ string{ "a" }, string{ "bcd" } },
+      config_entry<string, vector<int>>{ string{ "web" }, vector<int>{ 80, 443 } } };// NOLINT Magic Number
+  };
+
+  CONSTEXPR auto minimized = lefticus::tools::minimized_stackify<32>(make_data);// NOLINT Magic Number
+
+  STATIC_REQUIRE(std::get<0>(minimized)->capacity() == 8);// NOLINT Magic Number
+  STATIC_REQUIRE(std::get<1>(std::get<1>(minimized)).capacity() == 4);// NOLINT Magic Number
+  STATIC_REQUIRE(std::get<2>(minimized)[1].capacity() == 3);// NOLINT Magic Number
+  STATIC_REQUIRE(std::get<2>(minimized)[0] == "a");
+  STATIC_REQUIRE(std::get<3>(minimized).name == "web");
+  STATIC_REQUIRE(std::get<3>(minimized).values.capacity() == 2);
+  STATIC_REQUIRE(std::get<3>(minimized).values[1] == 443);// NOLINT Magic Number
+
+  STATIC_REQUIRE(sizeof(minimized) < sizeof(make_data()));
+}
+
+TEST_CASE("[minimized_stackify] only the active variant alternative is sized")
+{
+  const auto make_data = []() { return std::variant<string, int>{ 42 }; };// NOLINT Magic Number
+
+  CONSTEXPR auto minimized = lefticus::tools::minimized_stackify<32>(make_data);// NOLINT Magic Number
+
+  STATIC_REQUIRE(std::get<1>(minimized) == 42);// NOLINT Magic Number
+  STATIC_REQUIRE(std::variant_alternative_t<0, std::decay_t<decltype(minimized)>>::capacity() == 0);
+}
+
 
 #if __cpp_lib_constexpr_string >= 201907L && __cpp_lib_constexpr_vector >= 201907L
 
@@ -179,6 +300,23 @@ TEST_CASE("[minimized_stackify] works with std::vector, std::string")// NOLINT (
   STATIC_REQUIRE(minimized.at("hello").at("world").capacity() == 1);
 }
 
+// NOLINTNEXTLINE (cognitive complexity)
+TEST_CASE("[minimized_stackify] works with std types nested in std::optional and std::tuple")
+{
+  const auto make_data = []() {
+    return std::tuple{ std::optional<std::string>{ "hostname" },
+      std::vector<std::optional<std::string>>{ std::optional<std::string>{ "abc" }, std::nullopt } };
+  };
+
+  CONSTEXPR auto minimized = lefticus::tools::minimized_stackify<32>(make_data);// NOLINT Magic Number
+
+  STATIC_REQUIRE(std::get<0>(minimized)->capacity() == 8);// NOLINT Magic Number
+  STATIC_REQUIRE(std::get<0>(minimized).value() == "hostname");
+  STATIC_REQUIRE(std::get<1>(minimized).capacity() == 2);
+  STATIC_REQUIRE(std::get<1>(minimized)[0]->capacity() == 3);// NOLINT Magic Number
+  STATIC_REQUIRE(!std::get<1>(minimized)[1].has_value());
+}
+
 #else
 
 #pragma message("Visual Studio's debug iterators are not fully constexpr capable")
@@ -186,3 +324,72 @@ TEST_CASE("[minimized_stackify] works with std::vector, std::string")// NOLINT (
 #endif
 
 #endif
+
+namespace {
+constexpr std::uint8_t reverse_bits(std::uint8_t value)
+{
+  std::uint8_t result = 0;
+  for (unsigned bit = 0U; bit < 8U; ++bit) {// NOLINT Magic Number
+    result = static_cast<std::uint8_t>((unsigned{ result } << 1U) | ((unsigned{ value } >> bit) & 1U));
+  }
+  return result;
+}
+
+// the reflected CRC-32 table, one entry per byte value
+constexpr std::uint32_t crc32_entry(std::uint8_t value)
+{
+  std::uint32_t crc = value;
+  for (unsigned bit = 0U; bit < 8U; ++bit) {// NOLINT Magic Number
+    crc = (crc & 1U) != 0 ? (crc >> 1U) ^ 0xEDB88320U : crc >> 1U;// NOLINT Magic Number
+  }
+  return crc;
+}
+
+constexpr std::int32_t cube(lefticus::tools::int_np<std::int8_t> value)
+{
+  const std::int32_t raw = value.get();
+  return raw * raw * raw;
+}
+
+constexpr double square(double value) { return value * value; }
+}// namespace
+
+TEST_CASE("[make_lut] tabulates a function over a whole integral type")
+{
+  static constexpr auto reversed = lefticus::tools::make_lut<reverse_bits, std::uint8_t>();
+  STATIC_REQUIRE(reversed.size() == 256);
+  STATIC_REQUIRE(reversed[0x01] == 0x80);
+  STATIC_REQUIRE(reversed[0xF0] == 0x0F);
+
+  static constexpr auto crc = lefticus::tools::make_lut<crc32_entry, std::uint8_t>();
+  STATIC_REQUIRE(crc[1] == 0x77073096U);
+  STATIC_REQUIRE(crc[255] == 0x2D02EF8DU);
+}
+
+TEST_CASE("[make_lut] supports int_np and partial ranges")
+{
+  using key = lefticus::tools::int_np<std::int8_t>;
+  static constexpr auto cubes = lefticus::tools::make_lut<cube, key>();
+  STATIC_REQUIRE(cubes.size() == 256);
+  STATIC_REQUIRE(cubes[key::from(-128)] == -2097152);
+  STATIC_REQUIRE(cubes[key::from(5)] == 125);
+
+  static constexpr auto small = lefticus::tools::make_lut<cube, lefticus::tools::lut_range<key, -2, 3>>();
+  STATIC_REQUIRE(small.size() == 6);
+  STATIC_REQUIRE(small[key::from(-2)] == -8);
+  STATIC_REQUIRE(small.at(key::from(3)) == 27);
+  CHECK_THROWS_AS(small.at(key::from(4)), std::out_of_range);
+  CHECK_THROWS_AS(small.at(key::from(-3)), std::out_of_range);
+}
+
+TEST_CASE("[make_lut] interpolates floating point domains")
+{
+  static constexpr auto squares = lefticus::tools::make_lut<square, lefticus::tools::lut_interval<0.0, 4.0, 5>>();
+  STATIC_REQUIRE(squares.size() == 5);
+  // exact at the samples, linear between them, clamped outside
+  STATIC_REQUIRE(squares(2.0) == 4.0);
+  STATIC_REQUIRE(squares(2.5) == 6.5);
+  STATIC_REQUIRE(squares(4.0) == 16.0);
+  STATIC_REQUIRE(squares(-1.0) == 0.0);
+  STATIC_REQUIRE(squares(10.0) == 16.0);
+}
@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/strong_types.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// strong_alias should cost nothing over the type it wraps; each pair here
+// runs the same loop over raw doubles and over strong_alias<double>.
+// test/codegen checks the generated instructions for the same loops.
+
+using meters = lefticus::tools::strong_alias<double, struct meters_tag>;
+using ratio = lefticus::tools::strong_alias<double, struct ratio_tag>;
+
+auto add(meters, meters) -> meters;
+auto multiply(meters, ratio) -> meters;
+auto order(meters, meters) -> bool;
+
+namespace {
+constexpr std::size_t sample_count = 1 << 16;
+
+std::vector<double> make_samples(std::uint32_t seed)
+{
+  std::vector<double> result;
+  result.reserve(sample_count);
+  for (std::size_t index = 0; index < sample_count; ++index) {
+    seed = seed * 1103515245U + 12345U;// NOLINT Magic Number
+    result.push_back(static_cast<double>(seed >> 16U) / 65536.0);// NOLINT Magic Number
+  }
+  return result;
+}
+
+std::vector<meters> to_meters(const std::vector<double> &values)
+{
+  std::vector<meters> result;
+  result.reserve(values.size());
+  for (const auto value : values) { result.emplace_back(value); }
+  return result;
+}
+}// namespace
+
+TEST_CASE("[strong_alias] element-wise add", "[!benchmark]")
+{
+  const auto raw_lhs = make_samples(1);
+  const auto raw_rhs = make_samples(2);
+  const auto lhs = to_meters(raw_lhs);
+  const auto rhs = to_meters(raw_rhs);
+
+  std::vector<double> raw_result(sample_count);
+  std::vector<meters> result(sample_count);
+
+  BENCHMARK("strong_alias<double>")
+  {
+    std::transform(lhs.begin(), lhs.end(), rhs.begin(), result.begin(), [](auto left, auto right) {
+      return left + right;
+    });
+    return result.back();
+  };
+
+  BENCHMARK("double")
+  {
+    std::transform(raw_lhs.begin(), raw_lhs.end(), raw_rhs.begin(), raw_result.begin(), [](auto left, auto right) {
+      return left + right;
+    });
+    return raw_result.back();
+  };
+}
+
+TEST_CASE("[strong_alias] scale and accumulate", "[!benchmark]")
+{
+  const auto raw_values = make_samples(3);
+  const auto values = to_meters(raw_values);
+  constexpr double factor = 1.5;
+
+  BENCHMARK("strong_alias<double>")
+  {
+    meters total{};
+    for (const auto value : values) { total = total + value * ratio{ factor }; }
+    return total;
+  };
+
+  BENCHMARK("double")
+  {
+    double total{};
+    for (const auto value : raw_values) { total = total + value * factor; }
+    return total;
+  };
+}
+
+TEST_CASE("[strong_alias] sort", "[!benchmark]")
+{
+  const auto raw_values = make_samples(4);
+  const auto values = to_meters(raw_values);
+
+  BENCHMARK_ADVANCED("strong_alias<double>")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector copies(static_cast<std::size_t>(meter.runs()), values);
+    meter.measure([&](int run) {
+      auto &copy = copies[static_cast<std::size_t>(run)];
+      std::sort(copy.begin(), copy.end());
+      return copy.front();
+    });
+  };
+
+  BENCHMARK_ADVANCED("double")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector copies(static_cast<std::size_t>(meter.runs()), raw_values);
+    meter.measure([&](int run) {
+      auto &copy = copies[static_cast<std::size_t>(run)];
+      std::sort(copy.begin(), copy.end());
+      return copy.front();
+    });
+  };
+}
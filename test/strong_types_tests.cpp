@@ -5,6 +5,8 @@
 #include <catch2/catch.hpp>
 #include <lefticus/tools/strong_types.hpp>
 
+#include <stdexcept>
+
 #ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
 #define CONSTEXPR
 #else
@@ -177,3 +179,158 @@ TEST_CASE("Strong types sanity checks")
 
   draw_players(Time{ 4.3f });
 }
+
+template<typename LHS, typename RHS> consteval bool types_less_than_comparable()
+{
+  return requires(LHS lhs, RHS rhs) { lhs < rhs; };
+}
+
+TEST_CASE("Strong types have the layout of their underlying type")
+{
+  STATIC_REQUIRE(sizeof(Time) == sizeof(float));
+  STATIC_REQUIRE(alignof(Time) == alignof(float));
+  STATIC_REQUIRE(std::is_trivially_copyable_v<Time>);
+  STATIC_REQUIRE(std::is_standard_layout_v<Time>);
+
+  STATIC_REQUIRE(sizeof(Player1_Position) == sizeof(Point));
+  STATIC_REQUIRE(std::is_trivially_copyable_v<Player1_Position>);
+  STATIC_REQUIRE(std::is_standard_layout_v<Player1_Position>);
+
+  STATIC_REQUIRE(!std::is_trivially_copyable_v<Pattern>);
+}
+
+TEST_CASE("Strong types relational operators")
+{
+  CONSTEXPR Time early{ 1.0f };
+  CONSTEXPR Time late{ 2.0f };
+
+  STATIC_REQUIRE(early < late);
+  STATIC_REQUIRE(late > early);
+  STATIC_REQUIRE(early <= early);
+  STATIC_REQUIRE(late >= early);
+  STATIC_REQUIRE(!(late < early));
+  STATIC_REQUIRE(!(early >= late));
+
+  STATIC_REQUIRE(types_less_than_comparable<Time, Time>());
+  STATIC_REQUIRE(!types_less_than_comparable<Player1_Velocity, Player1_Velocity>());
+}
+
+using Distance = lefticus::tools::strong_alias<int, struct Dist>;
+using Scale = lefticus::tools::strong_alias<int, struct Sca>;
+
+auto add(Distance, Distance) -> Distance;
+auto subtract(Distance, Distance) -> Distance;
+auto multiply(Distance, Scale) -> Distance;
+auto divide(Distance, Scale) -> Distance;
+auto increment(Distance) -> Distance;
+auto decrement(Distance) -> Distance;
+
+constexpr void non_negative(const int &value)
+{
+  if (value < 0) { throw std::range_error("value must not be negative"); }
+}
+
+using Count = lefticus::tools::strong_alias<int, struct Cnt, non_negative>;
+using DebugCount = lefticus::tools::strong_alias<int, struct DCnt, lefticus::tools::debug_only<non_negative>>;
+using LooseCount = lefticus::tools::strong_alias<int, struct LCnt, non_negative>;
+
+auto add(Count, Count) -> Count;
+auto subtract(Count, Count) -> Count;
+auto decrement(Count) -> Count;
+auto validate_in_place(Count) -> void;
+auto decrement(LooseCount) -> LooseCount;
+auto subtract(DebugCount, DebugCount) -> DebugCount;
+auto decrement(DebugCount) -> DebugCount;
+
+template<typename LHS, typename RHS> consteval bool types_add_assignable()
+{
+  return requires(LHS lhs, RHS rhs) { lhs += rhs; };
+}
+
+template<typename Value> consteval bool type_incrementable()
+{
+  return requires(Value value) { ++value; };
+}
+
+TEST_CASE("Strong types compound assignment")
+{
+  STATIC_REQUIRE([] {
+    Distance distance{ 10 };
+    distance += Distance{ 5 };
+    distance -= Distance{ 3 };
+    distance *= Scale{ 4 };
+    distance /= Scale{ 6 };
+    return distance.get();
+  }() == 8);
+
+  STATIC_REQUIRE([] {
+    Distance distance{ 1 };
+    return (distance += Distance{ 2 }).get();
+  }() == 3);
+
+  // Position + Displacement is a Position, but Displacement + Position is not a Displacement
+  STATIC_REQUIRE(types_add_assignable<Distance, Distance>());
+  STATIC_REQUIRE(!types_add_assignable<Scale, Scale>());
+  STATIC_REQUIRE(!types_add_assignable<Distance, Scale>());
+  STATIC_REQUIRE(!types_add_assignable<const Distance, Distance>());
+  STATIC_REQUIRE(!types_add_assignable<Player1_Displacement, Player1_Position>());
+
+  STATIC_REQUIRE(noexcept(std::declval<Distance &>() += std::declval<const Distance &>()));
+}
+
+TEST_CASE("Strong types increment and decrement")
+{
+  STATIC_REQUIRE([] {
+    Distance distance{ 5 };
+    ++distance;
+    ++distance;
+    --distance;
+    return distance.get();
+  }() == 6);
+
+  STATIC_REQUIRE([] {
+    Distance distance{ 5 };
+    const auto before = distance++;
+    const auto after = distance--;
+    return before.get() * 100 + after.get() * 10 + distance.get();// NOLINT Magic Number
+  }() == 565);// NOLINT Magic Number
+
+  STATIC_REQUIRE(type_incrementable<Distance>());
+  STATIC_REQUIRE(!type_incrementable<Scale>());
+  STATIC_REQUIRE(!type_incrementable<Count>());
+}
+
+TEST_CASE("Strong types validate in-place modification")
+{
+  Count count{ 1 };
+  count -= Count{ 1 };
+  CHECK(count.get() == 0);
+  CHECK_THROWS_AS(--count, std::range_error);
+  CHECK_THROWS_AS(count -= Count{ 1 }, std::range_error);
+  CHECK_THROWS_AS(Count{ -1 }, std::range_error);
+
+  STATIC_REQUIRE(!noexcept(std::declval<Count &>() -= std::declval<const Count &>()));
+  STATIC_REQUIRE(noexcept(--std::declval<DebugCount &>()) == !lefticus::tools::debug_validation);
+
+  DebugCount debug_count{ 0 };
+  if constexpr (lefticus::tools::debug_validation) {
+    CHECK_THROWS_AS(--debug_count, std::range_error);
+  } else {
+    --debug_count;
+    CHECK(debug_count.get() == -1);
+  }
+}
+
+TEST_CASE("Strong types only validate in-place modification in debug builds unless asked to")
+{
+  STATIC_REQUIRE(noexcept(--std::declval<LooseCount &>()) == !lefticus::tools::debug_validation);
+
+  LooseCount count{ 0 };
+  if constexpr (lefticus::tools::debug_validation) {
+    CHECK_THROWS_AS(--count, std::range_error);
+  } else {
+    --count;
+    CHECK(count.get() == -1);
+  }
+  CHECK_THROWS_AS(LooseCount{ -1 }, std::range_error);
+}
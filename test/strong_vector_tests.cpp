@@ -0,0 +1,83 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/strong_vector.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+using lefticus::tools::strong_index;
+using lefticus::tools::strong_vector;
+
+using NodeIndex = strong_index<struct NodeTag>;
+using EdgeIndex = strong_index<struct EdgeTag>;
+
+template<typename Container, typename Index> consteval bool indexable_by()
+{
+  return requires(Container container, Index index) { container[index]; };
+}
+
+TEST_CASE("strong_vector indices come from push_back")
+{
+  STATIC_REQUIRE([] {
+    strong_vector<NodeIndex, int> nodes;
+    const auto first = nodes.push_back(10);// NOLINT Magic Number
+    const auto second = nodes.emplace_back(20);// NOLINT Magic Number
+    return first.get() == 0 && second.get() == 1 && nodes[first] == 10 && nodes[second] == 20;
+  }());
+
+  STATIC_REQUIRE(indexable_by<strong_vector<NodeIndex, int>, NodeIndex>());
+  STATIC_REQUIRE(!indexable_by<strong_vector<NodeIndex, int>, EdgeIndex>());
+  STATIC_REQUIRE(!indexable_by<strong_vector<NodeIndex, int>, std::size_t>());
+}
+
+TEST_CASE("strong_vector is backed by std::vector or simple_stack_vector")
+{
+  STATIC_REQUIRE([] {
+    lefticus::tools::simple_stack_strong_vector<NodeIndex, int, 4> nodes;
+    nodes.push_back(1);
+    nodes.push_back(2);
+    nodes.push_back(3);
+    int total = 0;
+    for (const auto index : nodes.indices()) { total += nodes[index]; }
+    return total;
+  }() == 6);
+
+  CONSTEXPR lefticus::tools::simple_stack_strong_vector<EdgeIndex, int, 4> edges{ 4, 5, 6 };// NOLINT Magic Number
+  STATIC_REQUIRE(edges.size() == 3);
+  STATIC_REQUIRE(edges.next_index().get() == 3);
+  STATIC_REQUIRE(edges.contains(EdgeIndex{ 2U }));
+  STATIC_REQUIRE(!edges.contains(EdgeIndex{ 3U }));
+  STATIC_REQUIRE(edges.at(EdgeIndex{ 1U }) == 5);
+}
+
+TEST_CASE("strong_vector at() checks bounds")
+{
+  strong_vector<NodeIndex, std::string> names;
+  const auto index = names.push_back("root");
+  CHECK(names.at(index) == "root");
+  CHECK_THROWS_AS(names.at(NodeIndex{ 1U }), std::out_of_range);
+
+  STATIC_REQUIRE(noexcept(names[index]) == !lefticus::tools::debug_validation);
+  if constexpr (lefticus::tools::debug_validation) { CHECK_THROWS_AS(names[NodeIndex{ 1U }], std::out_of_range); }
+
+  lefticus::tools::simple_stack_strong_vector<NodeIndex, int, 1> full;
+  full.push_back(1);
+  CHECK_THROWS_AS(full.push_back(2), std::length_error);
+}
+
+TEST_CASE("strong_vector index type limits the size")
+{
+  using SmallIndex = lefticus::tools::strong_alias<std::uint8_t, struct SmallTag>;
+  strong_vector<SmallIndex, char> small;
+  CHECK(small.max_size() == 255);
+  small.resize(255);// NOLINT Magic Number
+  CHECK_THROWS_AS(small.push_back('x'), std::length_error);
+  CHECK_THROWS_AS(small.resize(256), std::length_error);// NOLINT Magic Number
+}
@@ -2,6 +2,8 @@
 
 
 #include <array>
+#include <map>
+#include <optional>
 #include <utility>
 
 #include <lefticus/tools/curry.hpp>
@@ -264,3 +266,16 @@ TEST_CASE("[flat_map_adapter] stackify level 4")// NOLINT (cognitive complexity)
   REQUIRE(max_sizes.second.second.first == 4);// NOLINT Magic Number
   REQUIRE(max_sizes.second.second.second == 15);// NOLINT Magic Number
 }
+
+TEST_CASE("[std::map] stackify produces a simple_stack_flat_map")// NOLINT (cognitive complexity)
+{
+  const std::map<std::string, std::optional<std::string>> map{ { "Hello", "There" }, { "World", std::nullopt } };
+
+  const auto stack_map = lefticus::tools::stackify<16>(map);// NOLINT Magic Number
+  static_assert(std::is_same_v<typename decltype(stack_map)::mapped_type,
+    std::optional<lefticus::tools::simple_stack_string<16>>>);// NOLINT Magic Number
+
+  REQUIRE(stack_map.size() == 2);
+  REQUIRE(stack_map.at("Hello").value() == "There");
+  REQUIRE(!stack_map.at("World").has_value());
+}
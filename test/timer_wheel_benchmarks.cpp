@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/timer_wheel.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+// Per-connection idle timers: every connection has one, activity on a
+// connection pushes its timeout back, and time then runs until all expire.
+// The priority_queue cannot cancel, so resets leave stale entries behind that
+// are skipped when they surface.
+
+namespace {
+constexpr std::size_t connection_count = 1 << 16;
+constexpr std::size_t activity_count = 1 << 18;
+constexpr std::uint64_t idle_timeout = 30000;
+
+struct no_tasks
+{
+  std::size_t notify_all(lefticus::tools::lambda_coroutines::wait_queue &) noexcept { return 0; }
+};
+
+// which connection is active at each step
+std::vector<std::uint32_t> make_activity(std::uint32_t seed)
+{
+  std::vector<std::uint32_t> result;
+  result.reserve(activity_count);
+  for (std::size_t index = 0; index < activity_count; ++index) {
+    seed = seed * 1103515245U + 12345U;// NOLINT Magic Number
+    result.push_back((seed >> 8U) % connection_count);// NOLINT Magic Number
+  }
+  return result;
+}
+}// namespace
+
+TEST_CASE("[timer_wheel] idle timers", "[!benchmark]")
+{
+  const auto activity = make_activity(1);
+
+  BENCHMARK("timer_wheel")
+  {
+    using wheel = lefticus::tools::lambda_coroutines::timer_wheel<connection_count>;
+    auto timers = std::make_unique<wheel>();
+    no_tasks tasks;
+    std::vector<lefticus::tools::lambda_coroutines::timer_id> ids(connection_count);
+    for (auto &id : ids) { id = timers->start(idle_timeout); }
+    for (const auto connection : activity) {
+      timers->cancel(ids[connection]);
+      ids[connection] = timers->start(idle_timeout);
+      timers->advance(tasks, connection & 1U);
+    }
+    timers->advance(tasks, idle_timeout);
+    return timers->size();
+  };
+
+  BENCHMARK("std::priority_queue")
+  {
+    struct entry
+    {
+      std::uint64_t expires;
+      std::uint32_t connection;
+      std::uint32_t version;
+
+      bool operator>(const entry &other) const noexcept { return expires > other.expires; }
+    };
+
+    std::priority_queue<entry, std::vector<entry>, std::greater<>> timers;
+    std::vector<std::uint32_t> versions(connection_count);
+    std::uint64_t now = 0;
+    std::size_t expired = 0;
+
+    const auto advance = [&](const std::uint64_t ticks) {
+      now += ticks;
+      while (!timers.empty() && timers.top().expires <= now) {
+        if (timers.top().version == versions[timers.top().connection]) { ++expired; }
+        timers.pop();
+      }
+    };
+
+    for (std::uint32_t connection = 0; connection < connection_count; ++connection) {
+      timers.push(entry{ now + idle_timeout, connection, 0 });
+    }
+    for (const auto connection : activity) {
+      timers.push(entry{ now + idle_timeout, connection, ++versions[connection] });
+      advance(connection & 1U);
+    }
+    advance(idle_timeout);
+    return timers.size() + expired;
+  };
+}
@@ -0,0 +1,170 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/timer_wheel.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+using namespace lefticus::tools::lambda_coroutines;
+
+namespace {
+// never has a task to wake
+struct no_tasks
+{
+  constexpr std::size_t notify_all(wait_queue &) noexcept { return 0; }
+};
+
+// starts timers with every delay up to `longest`, some of them part way
+// through a turn of the wheel, and checks each expires on exactly its tick
+template<typename Wheel> constexpr bool expires_on_time(const std::uint64_t longest, const std::uint64_t offset)
+{
+  Wheel timers;
+  no_tasks tasks;
+  timers.advance(tasks, offset);
+
+  std::array<timer_id, Wheel::capacity()> ids{};
+  std::array<std::uint64_t, Wheel::capacity()> deadlines{};
+  std::size_t count = 0;
+  for (std::uint64_t delay = 1; delay <= longest; delay += 1 + delay / 8) {
+    ids.at(count) = timers.start(delay);
+    deadlines.at(count) = timers.now() + delay;
+    ++count;
+  }
+
+  while (!timers.empty()) {
+    timers.advance(tasks, 1);
+    for (std::size_t index = 0; index < count; ++index) {
+      if (timers.pending(ids.at(index)) != (timers.now() < deadlines.at(index))) { return false; }
+    }
+  }
+  return true;
+}
+
+struct trace
+{
+  std::array<std::uint64_t, 8> woke{};
+  std::size_t length = 0;
+};
+
+using wheel = timer_wheel<16, 3, 2>;
+
+constexpr auto make_sleeper(wheel &timers, trace &log, const std::uint64_t delay)
+{
+  return [state = 0, &timers, &log, delay]() mutable {
+    lambda_co_begin(state);
+    lambda_co_yield(timers.sleep_for(delay));
+    log.woke.at(log.length++) = timers.now();
+    lambda_co_return(task_step::done());
+  };
+}
+}// namespace
+
+TEST_CASE("timer_wheel expires every timer on its tick")
+{
+  // 4 slots a level, so most of these cascade at least once
+  STATIC_REQUIRE(expires_on_time<timer_wheel<64, 3, 2>>(60, 0));
+  STATIC_REQUIRE(expires_on_time<timer_wheel<64, 3, 2>>(60, 7));
+  // delays past the 64 tick horizon are parked and cascade again
+  STATIC_REQUIRE(expires_on_time<timer_wheel<64, 3, 2>>(300, 13));
+  STATIC_REQUIRE(expires_on_time<timer_wheel<64, 1, 3>>(40, 5));
+}
+
+TEST_CASE("timer_wheel advances over idle stretches in one call")
+{
+  STATIC_REQUIRE([] {
+    timer_wheel<4> timers;
+    no_tasks tasks;
+    const auto soon = timers.start(10);
+    const auto later = timers.start(5000);
+    const auto much_later = timers.start(100000);
+
+    timers.advance(tasks, 4999);
+    if (timers.pending(soon) || !timers.pending(later)) { return false; }
+    timers.advance(tasks, 1);
+    if (timers.pending(later) || !timers.pending(much_later)) { return false; }
+    timers.advance(tasks, 1000000);
+    return timers.empty() && timers.now() == 1005000;
+  }());
+}
+
+TEST_CASE("timer_wheel never expires a timer started with the largest delay")
+{
+  STATIC_REQUIRE([] {
+    timer_wheel<4> timers;
+    no_tasks tasks;
+    timers.advance(tasks, 3);
+    const auto never = timers.start(std::numeric_limits<std::uint64_t>::max());
+    timers.advance(tasks, 1);
+    timers.advance(tasks, 100000);// NOLINT Magic Number
+    return timers.pending(never);
+  }());
+}
+
+TEST_CASE("timer_wheel cancels and reuses timers")
+{
+  STATIC_REQUIRE([] {
+    timer_wheel<2> timers;
+    no_tasks tasks;
+    const auto first = timers.start(10);
+    const auto second = timers.start(20);
+    if (!timers.cancel(first) || timers.cancel(first) || timers.pending(first)) { return false; }
+
+    // the freed node is reused under a new generation
+    const auto third = timers.start(5);
+    if (third.index != first.index || third == first) { return false; }
+
+    timers.advance(tasks, 5);
+    return !timers.pending(third) && timers.pending(second) && timers.size() == 1;
+  }());
+}
+
+TEST_CASE("timer_wheel rejects misuse")
+{
+  timer_wheel<1> timers;
+  const auto id = timers.start(3);
+  CHECK_THROWS_AS(timers.start(1), std::length_error);
+  CHECK(timers.cancel(id));
+  CHECK_THROWS_AS(timers.wait(id), std::invalid_argument);
+}
+
+TEST_CASE("timer_wheel wakes sleeping tasks in deadline order")
+{
+  STATIC_REQUIRE([] {
+    wheel timers;
+    trace log;
+    scheduler<decltype(make_sleeper(timers, log, 0)), 4> tasks;
+    tasks.spawn(make_sleeper(timers, log, 30));
+    tasks.spawn(make_sleeper(timers, log, 3));
+    tasks.spawn(make_sleeper(timers, log, 12));
+    tasks.run();
+    if (timers.size() != 3 || tasks.has_ready()) { return false; }
+
+    std::size_t woken = 0;
+    while (!tasks.empty()) {
+      woken += timers.advance(tasks, 1);
+      tasks.run();
+    }
+    return woken == 3 && log.length == 3 && log.woke[0] == 3 && log.woke[1] == 12 && log.woke[2] == 30;
+  }());
+}
+
+TEST_CASE("timer_wheel refuses to cancel a timer with sleepers")
+{
+  wheel timers;
+  trace log;
+  scheduler<decltype(make_sleeper(timers, log, 0)), 1> tasks;
+  tasks.spawn(make_sleeper(timers, log, 2));
+  tasks.run();
+  CHECK_THROWS_AS(timers.cancel(timer_id{ 0, 1 }), std::logic_error);
+  timers.advance(tasks, 2);
+  tasks.run();
+  CHECK(tasks.empty());
+}
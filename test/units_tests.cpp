@@ -0,0 +1,134 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/units.hpp>
+
+#include <ratio>
+#include <type_traits>
+
+#ifdef CATCH_CONFIG_RUNTIME_STATIC_REQUIRE
+#define CONSTEXPR
+#else
+// NOLINTNEXTLINE
+#define CONSTEXPR constexpr
+#endif
+
+namespace units = lefticus::tools::units;
+
+template<typename LHS, typename RHS> consteval bool can_add()
+{
+  return requires(LHS lhs, RHS rhs) { lhs + rhs; };
+}
+
+template<typename LHS, typename RHS> consteval bool can_compare()
+{
+  return requires(LHS lhs, RHS rhs) { lhs < rhs; };
+}
+
+template<typename To, typename From> consteval bool can_cast()
+{
+  return requires(From from) { units::quantity_cast<To>(from); };
+}
+
+TEST_CASE("[units] dimensions are exponent lists")
+{
+  using units::exponent_v;
+
+  STATIC_REQUIRE(exponent_v<units::velocity, 0> == 1);
+  STATIC_REQUIRE(exponent_v<units::velocity, 2> == -1);
+  STATIC_REQUIRE(exponent_v<units::force, 0> == 1);
+  STATIC_REQUIRE(exponent_v<units::force, 1> == 1);
+  STATIC_REQUIRE(exponent_v<units::force, 2> == -2);
+  STATIC_REQUIRE(exponent_v<units::volume, 0> == 3);
+
+  STATIC_REQUIRE(std::is_same_v<units::product_t<units::velocity, units::duration>, units::length>);
+  STATIC_REQUIRE(std::is_same_v<units::quotient_t<units::length, units::length>, units::dimensionless>);
+  STATIC_REQUIRE(std::is_same_v<units::power_t<units::frequency, -1>, units::duration>);
+  STATIC_REQUIRE(std::is_same_v<units::quotient_t<units::power, units::current>,
+    units::quotient_t<units::energy, units::charge>>);
+}
+
+TEST_CASE("[units] products and quotients derive their unit")
+{
+  CONSTEXPR units::metres distance{ 100.0 };
+  CONSTEXPR units::seconds time{ 8.0 };
+  CONSTEXPR units::kilograms mass{ 2.0 };
+
+  CONSTEXPR auto speed = distance / time;
+  STATIC_REQUIRE(std::is_same_v<std::remove_const_t<decltype(speed)>, units::metres_per_second>);
+  STATIC_REQUIRE(speed.get() == 12.5);
+
+  CONSTEXPR auto force = mass * (speed / time);
+  STATIC_REQUIRE(std::is_same_v<std::remove_const_t<decltype(force)>, units::newtons>);
+
+  CONSTEXPR auto work = force * distance;
+  STATIC_REQUIRE(std::is_same_v<std::remove_const_t<decltype(work)>, units::joules>);
+  STATIC_REQUIRE(std::is_same_v<decltype(work / time), units::watts>);
+  STATIC_REQUIRE(std::is_same_v<decltype(distance / distance), units::scalar>);
+  STATIC_REQUIRE(std::is_same_v<decltype(distance * distance), units::square_metres>);
+  STATIC_REQUIRE(std::is_same_v<decltype(1.0 / time), units::hertz>);
+
+  // scales multiply along with the dimensions
+  STATIC_REQUIRE(std::is_same_v<decltype(units::kilometres{ 1.0 } / units::hours{ 1.0 }), units::kilometres_per_hour>);
+}
+
+TEST_CASE("[units] addition requires the same unit")
+{
+  CONSTEXPR units::metres lhs{ 1.5 };
+  CONSTEXPR units::metres rhs{ 2.0 };
+
+  STATIC_REQUIRE((lhs + rhs).get() == 3.5);
+  STATIC_REQUIRE((rhs - lhs).get() == 0.5);
+  STATIC_REQUIRE((-lhs).get() == -1.5);
+  STATIC_REQUIRE((lhs * 2.0).get() == 3.0);
+  STATIC_REQUIRE((2.0 * lhs).get() == 3.0);
+  STATIC_REQUIRE((rhs / 4.0).get() == 0.5);
+
+  STATIC_REQUIRE(can_add<units::metres, units::metres>());
+  STATIC_REQUIRE(!can_add<units::metres, units::seconds>());
+  STATIC_REQUIRE(!can_add<units::metres, units::kilometres>());
+  STATIC_REQUIRE(!can_add<units::metres, double>());
+}
+
+TEST_CASE("[units] comparison and compound assignment")
+{
+  CONSTEXPR units::seconds short_time{ 1.0 };
+  CONSTEXPR units::seconds long_time{ 2.0 };
+
+  STATIC_REQUIRE(short_time < long_time);
+  STATIC_REQUIRE(short_time != long_time);
+  STATIC_REQUIRE(short_time == units::seconds{ 1.0 });
+  STATIC_REQUIRE(!can_compare<units::seconds, units::milliseconds>());
+
+  STATIC_REQUIRE([] {
+    units::metres position{ 0.0 };
+    const units::metres_per_second velocity{ 3.0 };
+    const units::seconds step{ 0.5 };
+    for (int i = 0; i < 4; ++i) { position += velocity * step; }
+    position *= units::scalar{ 2.0 };
+    return position.get();
+  }() == 12.0);
+}
+
+TEST_CASE("[units] quantity_cast converts between scales")
+{
+  STATIC_REQUIRE(units::quantity_cast<units::metres>(units::kilometres{ 1.5 }).get() == 1500.0);
+  STATIC_REQUIRE(units::quantity_cast<units::kilometres>(units::metres{ 250.0 }).get() == 0.25);
+  STATIC_REQUIRE(units::quantity_cast<units::seconds>(units::hours{ 2.0 }).get() == 7200.0);
+  STATIC_REQUIRE(units::quantity_cast<units::metres_per_second>(units::kilometres_per_hour{ 36.0 }).get() == 10.0);
+
+  using integral_millimetres = units::quantity<units::length, std::milli, int>;
+  using integral_metres = units::quantity<units::length, std::ratio<1>, int>;
+  STATIC_REQUIRE(units::quantity_cast<integral_millimetres>(integral_metres{ 3 }).get() == 3000);
+  STATIC_REQUIRE(units::quantity_cast<integral_metres>(integral_millimetres{ 3999 }).get() == 3);
+  STATIC_REQUIRE(units::quantity_cast<units::metres>(integral_millimetres{ 1500 }).get() == 1.5);
+
+  STATIC_REQUIRE(can_cast<units::kilometres, units::metres>());
+  STATIC_REQUIRE(!can_cast<units::seconds, units::metres>());
+}
+
+TEST_CASE("[units] quantities have the layout of their representation")
+{
+  STATIC_REQUIRE(sizeof(units::newtons) == sizeof(double));
+  STATIC_REQUIRE(std::is_trivially_copyable_v<units::newtons>);
+  STATIC_REQUIRE(units::is_quantity<units::newtons>);
+  STATIC_REQUIRE(!units::is_quantity<double>);
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch.hpp>
+#include <lefticus/tools/work_stealing_executor.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Scaling of the work-stealing executor with worker count on a simulation
+// style load: 10000 devices, each doing a little arithmetic per step.
+// Compare each result with the single worker one.
+
+namespace {
+constexpr std::size_t device_count = 10000;
+constexpr int steps_per_device = 100;
+
+using lefticus::tools::lambda_coroutines::task_step;
+
+struct device
+{
+  std::uint64_t value = 0;
+  int remaining = steps_per_device;
+  int state = 0;
+
+  task_step operator()()
+  {
+    lambda_co_begin(state);
+    while (remaining-- > 0) {
+      for (int round = 0; round < 64; ++round) {// NOLINT Magic Number
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;// NOLINT Magic Number
+      }
+      lambda_co_yield(task_step::yield());
+    }
+    lambda_co_return(task_step::done());
+  }
+};
+
+using executor = lefticus::tools::lambda_coroutines::work_stealing_executor<device, device_count>;
+
+std::size_t simulate(executor &pool)
+{
+  for (std::size_t index = 0; index < device_count; ++index) { pool.spawn(device{ index }); }
+  pool.run();
+  return pool.size();
+}
+}// namespace
+
+TEST_CASE("[work_stealing_executor] scaling", "[!benchmark]")
+{
+  const std::size_t hardware = std::max(std::thread::hardware_concurrency(), 1U);
+  for (std::size_t workers = 1; workers <= hardware; workers *= 2) {
+    auto pool = std::make_unique<executor>(workers);
+    BENCHMARK(std::to_string(workers) + " workers") { return simulate(*pool); };
+  }
+}
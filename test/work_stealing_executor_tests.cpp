@@ -0,0 +1,241 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <lefticus/tools/work_stealing_executor.hpp>
+
+using lefticus::tools::lambda_coroutines::task_step;
+using lefticus::tools::lambda_coroutines::work_stealing_deque;
+using lefticus::tools::lambda_coroutines::work_stealing_executor;
+
+namespace {
+struct counting_task
+{
+  std::atomic<std::uint64_t> *steps = nullptr;
+  int remaining = 0;
+  int state = 0;
+
+  task_step operator()()
+  {
+    lambda_co_begin(state);
+    while (remaining > 0) {
+      --remaining;
+      steps->fetch_add(1, std::memory_order_relaxed);
+      lambda_co_yield(task_step::yield());
+    }
+    lambda_co_return(task_step::done());
+  }
+};
+}// namespace
+
+TEST_CASE("[work_stealing_deque] owner is LIFO, thieves are FIFO")
+{
+  work_stealing_deque deque{ 4 };
+  CHECK(deque.push(1));
+  CHECK(deque.push(2));
+  CHECK(deque.push(3));
+  CHECK(deque.push(4));
+  CHECK(!deque.push(5));// NOLINT Magic Number
+
+  CHECK(deque.pop() == 4U);
+  CHECK(deque.steal() == 1U);
+  CHECK(deque.pop() == 3U);
+  CHECK(deque.steal() == 2U);
+  CHECK(!deque.pop());
+  CHECK(!deque.steal());
+  CHECK(deque.empty());
+}
+
+TEST_CASE("[work_stealing_deque] every value is taken exactly once")
+{
+  constexpr std::uint32_t value_count = 100000;
+  work_stealing_deque deque{ value_count };
+  std::vector<std::atomic<int>> taken(value_count);
+  std::atomic<bool> done{ false };
+
+  std::vector<std::thread> thieves;
+  for (int thief = 0; thief < 3; ++thief) {
+    thieves.emplace_back([&] {
+      while (!done.load() || !deque.empty()) {
+        if (const auto value = deque.steal()) { taken[*value].fetch_add(1); }
+      }
+    });
+  }
+
+  for (std::uint32_t value = 0; value < value_count; ++value) {
+    deque.push(value);
+    if (value % 3 == 0) {
+      if (const auto popped = deque.pop()) { taken[*popped].fetch_add(1); }
+    }
+  }
+  done.store(true);
+  while (const auto value = deque.pop()) { taken[*value].fetch_add(1); }
+  for (auto &thief : thieves) { thief.join(); }
+
+  CHECK(std::all_of(taken.begin(), taken.end(), [](const auto &count) { return count.load() == 1; }));
+}
+
+TEST_CASE("[work_stealing_executor] runs every step of every task")
+{
+  constexpr std::size_t task_count = 1000;
+  constexpr int steps_per_task = 50;
+
+  std::atomic<std::uint64_t> steps{ 0 };
+  auto executor = std::make_unique<work_stealing_executor<counting_task, task_count>>(4);
+  for (std::size_t task = 0; task < task_count; ++task) { executor->spawn(counting_task{ &steps, steps_per_task }); }
+  CHECK(executor->size() == task_count);
+
+  executor->run();
+  CHECK(steps.load() == task_count * steps_per_task);
+  CHECK(executor->empty());
+
+  // slots are reused
+  executor->spawn(counting_task{ &steps, 1 });
+  executor->run();
+  CHECK(steps.load() == task_count * steps_per_task + 1);
+}
+
+TEST_CASE("[work_stealing_executor] tasks spawn onto their own worker")
+{
+  struct tree_task
+  {
+    std::atomic<int> *count = nullptr;
+    int depth = 0;
+    int state = 0;
+
+    task_step operator()(work_stealing_executor<tree_task, 1024> &executor)
+    {
+      lambda_co_begin(state);
+      count->fetch_add(1);
+      if (depth < 8) {// NOLINT Magic Number
+        executor.spawn(tree_task{ count, depth + 1 });
+        lambda_co_yield(task_step::yield());
+        executor.spawn(tree_task{ count, depth + 1 });
+      }
+      lambda_co_return(task_step::done());
+    }
+  };
+
+  std::atomic<int> count{ 0 };
+  work_stealing_executor<tree_task, 1024> executor{ 3 };
+  executor.spawn(tree_task{ &count, 0 });
+  executor.run();
+  CHECK(count.load() == 511);
+}
+
+TEST_CASE("[work_stealing_executor] yielded tasks take turns")
+{
+  struct turn_task
+  {
+    std::vector<int> *order = nullptr;
+    int id = 0;
+    int remaining = 0;
+    int state = 0;
+
+    task_step operator()()
+    {
+      lambda_co_begin(state);
+      while (remaining > 0) {
+        --remaining;
+        order->push_back(id);
+        lambda_co_yield(task_step::yield());
+      }
+      lambda_co_return(task_step::done());
+    }
+  };
+
+  std::vector<int> order;
+  work_stealing_executor<turn_task, 3> executor{ 1 };
+  for (int id = 0; id < 3; ++id) { executor.spawn(turn_task{ &order, id, 4 }); }
+  executor.run();
+
+  // every task runs once per round, whatever order a round is in
+  REQUIRE(order.size() == 12);// NOLINT Magic Number
+  for (std::size_t round = 0; round < 4; ++round) {
+    std::vector<int> turns(std::next(order.begin(), static_cast<std::ptrdiff_t>(round * 3)),
+      std::next(order.begin(), static_cast<std::ptrdiff_t>(round * 3 + 3)));
+    std::sort(turns.begin(), turns.end());
+    CHECK(turns == std::vector<int>{ 0, 1, 2 });
+  }
+}
+
+TEST_CASE("[work_stealing_executor] idle workers sleep until there is work")
+{
+  struct late_task
+  {
+    std::atomic<int> *count = nullptr;
+    int children = 0;
+    int state = 0;
+
+    task_step operator()(work_stealing_executor<late_task, 16> &executor)
+    {
+      lambda_co_begin(state);
+      // long enough for the other workers to go to sleep
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));// NOLINT Magic Number
+      for (int child = 0; child < children; ++child) { executor.spawn(late_task{ count, 0 }); }
+      count->fetch_add(1);
+      lambda_co_return(task_step::done());
+    }
+  };
+
+  std::atomic<int> count{ 0 };
+  work_stealing_executor<late_task, 16> executor{ 4 };
+  executor.spawn(late_task{ &count, 8 });
+  executor.run();
+  CHECK(count.load() == 9);
+}
+
+TEST_CASE("[work_stealing_executor] stopping leaves tasks to resume later")
+{
+  struct forever_task
+  {
+    std::atomic<std::uint64_t> *steps = nullptr;
+    work_stealing_executor<forever_task, 8> *owner = nullptr;
+    int state = 0;
+
+    task_step operator()()
+    {
+      lambda_co_begin(state);
+      while (true) {
+        if (steps->fetch_add(1) == 1000) { owner->request_stop(); }// NOLINT Magic Number
+        lambda_co_yield(task_step::yield());
+      }
+      lambda_co_return(task_step::done());
+    }
+  };
+
+  std::atomic<std::uint64_t> steps{ 0 };
+  work_stealing_executor<forever_task, 8> executor{ 2 };
+  for (int task = 0; task < 8; ++task) { executor.spawn(forever_task{ &steps, &executor }); }
+  executor.run();
+  CHECK(steps.load() > 1000);
+  CHECK(executor.size() == 8);
+}
+
+TEST_CASE("[work_stealing_executor] rethrows task exceptions")
+{
+  struct throwing_task
+  {
+    int state = 0;
+
+    task_step operator()()
+    {
+      lambda_co_begin(state);
+      lambda_co_yield(task_step::yield());
+      throw std::runtime_error("device failed");
+      lambda_co_end();
+    }
+  };
+
+  work_stealing_executor<throwing_task, 4> executor{ 2 };
+  executor.spawn(throwing_task{});
+  CHECK_THROWS_AS(executor.run(), std::runtime_error);
+  CHECK(executor.empty());
+}